@@ -41,10 +41,13 @@ then
    fi
 fi
 
+SOURCES=""
 for i in $FILE_LIST
 do
-   $DF_EXE ${SRC_DIR}$i 1>"${i%cpp}gv"
+   SOURCES="$SOURCES ${SRC_DIR}$i"
 done
+$DF_EXE --outdir . $SOURCES
+[ "$?" != "0" ] && exit 1
 
 doxygen
 
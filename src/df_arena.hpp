@@ -0,0 +1,125 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!      @brief Arena allocator for the objects of the graph model           */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_arena.hpp                                                    */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#ifndef _DF_ARENA_HPP
+#define _DF_ARENA_HPP
+
+#ifndef __DOCFSM__
+ #include <stdlib.h>
+ #include <new>
+ #include <vector>
+ #include <utility>
+ #include <type_traits>
+#endif
+
+namespace DocFsm
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Allocates the objects of the graph model (states, transitions and
+ *        attributes) one after the other in big memory blocks.
+ *
+ * The objects can't be deleted individually, they live as long as
+ * the arena. The destructor of the arena invokes the destructors of the
+ * objects which need one and releases all blocks at once.
+ */
+class Arena
+{
+   static constexpr std::size_t BLOCK_SIZE = 64 * 1024;
+
+   struct DESTRUCTOR_T
+   {
+      void (*m_pDestroy)( void* );
+      void*  m_pObject;
+   };
+
+   std::vector<char*>         m_vpBlocks;
+   std::vector<DESTRUCTOR_T>  m_vDestructors;
+   char*                      m_pCurrent;
+   std::size_t                m_free;
+
+public:
+   Arena( void )
+      :m_pCurrent( nullptr )
+      ,m_free( 0 )
+   {}
+
+   ~Arena( void )
+   {
+      clear();
+   }
+
+   Arena( const Arena& ) = delete;
+   Arena& operator=( const Arena& ) = delete;
+
+   /*!
+    * @brief Constructs a object of the type T within the arena.
+    */
+   template< typename T, typename... ARGS >
+   T* create( ARGS&&... args )
+   {
+      T* pObject = new( allocate( sizeof( T ), alignof( T ) ) )
+                                              T( std::forward<ARGS>( args )... );
+      if( !std::is_trivially_destructible<T>::value )
+         m_vDestructors.push_back( { &destroy<T>, pObject } );
+      return pObject;
+   }
+
+   /*!
+    * @brief Destroys all objects and releases all blocks, the arena
+    *        can be used again afterwards.
+    */
+   void clear( void )
+   {
+      for( auto it = m_vDestructors.rbegin(); it != m_vDestructors.rend(); ++it )
+         it->m_pDestroy( it->m_pObject );
+      m_vDestructors.clear();
+      for( auto& pBlock : m_vpBlocks )
+         ::free( pBlock );
+      m_vpBlocks.clear();
+      m_pCurrent = nullptr;
+      m_free = 0;
+   }
+
+private:
+   template< typename T >
+   static void destroy( void* pObject )
+   {
+      static_cast<T*>( pObject )->~T();
+   }
+
+   void* allocate( std::size_t size, std::size_t alignment )
+   {
+      std::size_t padding = reinterpret_cast<std::size_t>( m_pCurrent ) & (alignment - 1);
+      if( padding != 0 )
+         padding = alignment - padding;
+
+      if( (m_pCurrent == nullptr) || (padding + size > m_free) )
+      {
+         const std::size_t blockSize = (size > BLOCK_SIZE)? size : BLOCK_SIZE;
+         m_pCurrent = static_cast<char*>( ::malloc( blockSize ) );
+         if( m_pCurrent == nullptr )
+            throw std::bad_alloc();
+         m_vpBlocks.push_back( m_pCurrent );
+         m_free = blockSize;
+         padding = 0;
+      }
+
+      void* p = m_pCurrent + padding;
+      m_pCurrent += padding + size;
+      m_free -= padding + size;
+      return p;
+   }
+};
+
+} // End namespace DocFsm
+#endif // ifndef _DF_ARENA_HPP
+//================================== EOF ======================================
@@ -16,8 +16,9 @@ using namespace DocFsm;
 
 /*!----------------------------------------------------------------------------
 */
-AttributeReader::AttributeReader( void )
-   :m_pAttrList(nullptr)
+AttributeReader::AttributeReader( Arena& rArena )
+   :m_rArena( rArena )
+   ,m_pAttrList(nullptr)
    ,m_poSourceBrowser(nullptr)
    ,m_pDotKeywords(nullptr)
    ,m_currentChar( '\0' )
@@ -235,7 +236,7 @@ void AttributeReader::ReadValueExit( void )
 {
    assert( dynamic_cast<ATTR_LIST_T*>( m_pAttrList ) != nullptr );
 
-   std::string* pValue = new std::string;
+   std::string* pValue = m_rArena.create<std::string>();
    for( const auto& c : m_value )
    {
       if( c != 'n' && pValue->back() == '\\' )
@@ -243,9 +244,9 @@ void AttributeReader::ReadValueExit( void )
       pValue->push_back( c );
    }
 
-   ATTR_T* pAttr = new ATTR_T( *m_currentDotKeyword, pValue );
+   ATTR_T* pAttr = m_rArena.create<ATTR_T>( *m_currentDotKeyword, pValue );
 #ifdef _DEBUG_ATTRIBUTE_READER
-   std::cerr << YELLOW "ATTRIBUT: " << std::get<0>(pAttr->first) << " = "
+   std::cerr << YELLOW "ATTRIBUT: " << DotKeywords::getKeyWord( pAttr->first ) << " = "
              << *pAttr->second << NORMAL << std::endl;
 #endif
    m_pAttrList->push_back( pAttr );
@@ -39,6 +39,7 @@ class AttributeReader: public Keyword
 
    FSM_CLASS_IMPLEMENT( AttributeReader )
 
+   Arena&                              m_rArena;
    ATTR_LIST_T*                        m_pAttrList;
    SourceBrowser*                      m_poSourceBrowser;
    const DotKeywords::DOT_ATTR_LIST_T* m_pDotKeywords;
@@ -50,7 +51,7 @@ class AttributeReader: public Keyword
 
 public:
 
-   AttributeReader( void );
+   AttributeReader( Arena& rArena );
 
    void start( SourceBrowser& roSorceBrowser, 
                const DotKeywords::DOT_ATTR_LIST_T& roDotKeywords,
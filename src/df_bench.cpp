@@ -0,0 +1,263 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!  @brief Main-module of DOCFSM_BENCH, measures the throughput of the      */
+/*!         processing stages of DocFsm.                                     */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_bench.cpp                                                    */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <iomanip>
+
+#include "df_commandline.hpp"
+#include "df_preparser.hpp"
+#include "df_cpp_caller.hpp"
+#include "df_dotgenerator.hpp"
+#include "df_transition_finder.hpp"
+#include "df_dot_keywords.hpp"
+#include "df_dot_writer.hpp"
+#include "df_fsm_generator.hpp"
+#include "df_stopwatch.hpp"
+#include "df_docfsm.hpp"
+
+using namespace DocFsm;
+
+enum STAGE_T
+{
+   CPP,
+   PREPARSE,
+   COLLECT,
+   TRANSITIONS,
+   CLUSTERING,
+   PRINT,
+   STAGES
+};
+
+static const char* const c_stageNames[STAGES] =
+{
+   "cpp",
+   "preparse",
+   "collect",
+   "transitions",
+   "clustering",
+   "print"
+};
+
+/*!----------------------------------------------------------------------------
+*/
+static std::size_t fileSize( const std::string& rFileName )
+{
+   struct stat status;
+   if( ::stat( rFileName.c_str(), &status ) != 0 )
+      return 0;
+   return status.st_size;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+static void removeGenerated( const std::string& rDirectory,
+                             const FsmGenerator::FILE_NAME_LIST_T& rFiles )
+{
+   for( auto& fileName : rFiles )
+      ::unlink( fileName.c_str() );
+   ::rmdir( rDirectory.c_str() );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+static void report( std::ostream& rOut, const StopWatch* pWatches,
+                    std::size_t files, std::size_t sourceBytes,
+                    std::size_t preprocessedBytes, std::size_t preparsedBytes,
+                    std::size_t dotBytes )
+{
+   rOut << "files:              " << files << "\n"
+           "source bytes:       " << sourceBytes << "\n"
+           "preprocessed bytes: " << preprocessedBytes << "\n"
+           "preparsed bytes:    " << preparsedBytes << "\n"
+           "DOT bytes:          " << dotBytes << "\n\n";
+
+   rOut << std::left << std::setw( 14 ) << "stage"
+        << std::right << std::setw( 14 ) << "wall [ms]"
+        << std::setw( 14 ) << "CPU [ms]" << "\n";
+
+   double wall = 0.0;
+   double cpu  = 0.0;
+   rOut << std::fixed << std::setprecision( 3 );
+   for( int i = 0; i < STAGES; i++ )
+   {
+      rOut << std::left << std::setw( 14 ) << c_stageNames[i]
+           << std::right << std::setw( 14 ) << pWatches[i].getWall() * 1000.0
+           << std::setw( 14 ) << pWatches[i].getCpu() * 1000.0 << "\n";
+      wall += pWatches[i].getWall();
+      cpu  += pWatches[i].getCpu();
+   }
+   rOut << std::left << std::setw( 14 ) << "total"
+        << std::right << std::setw( 14 ) << wall * 1000.0
+        << std::setw( 14 ) << cpu * 1000.0 << "\n";
+
+   if( wall > 0.0 )
+   {
+      rOut << "\nthroughput:         "
+           << preprocessedBytes / wall / (1024.0 * 1024.0)
+           << " MiB/s preprocessed source\n";
+   }
+   rOut << std::flush;
+}
+
+//=============================================================================
+
+int main( int argc, char** ppArgv )
+{
+   std::string   cppOutput;
+   std::string   out;
+
+   try
+   {
+      CommandlineParser  oCommandlineParser( argc, ppArgv );
+      FsmGenerator       generator( oCommandlineParser );
+      KeywordPool        oKeywordPool( oCommandlineParser );
+      CppCaller          cppCaller( cppOutput, oCommandlineParser );
+      SourceBrowser      sourceBrowser( out );
+      StateCollector     collector( sourceBrowser, oKeywordPool, oCommandlineParser );
+      TransitionFinder   transitionFinder( collector, oCommandlineParser );
+      DotKeywords        dotKeyWords( oCommandlineParser );
+
+      oCommandlineParser.setUsage(
+         "DocFsm-Bench measures the throughput of the processing stages of DocFsm:\n"
+         "preprocessing, preparsing, collecting of the states, finding of the\n"
+         "transitions, clustering and printing of the DOT-code.\n\n"
+         "Usage: " + std::string( ppArgv[0] ) + " [options,...] [C/C++ sourcefile ...]\n\n"
+         "Without source-files a synthetic corpus of FSMs becomes generated,\n"
+         "its size and shape is given by the options \"--gen-...\".\n"
+         "All files become processed to one graph, whose DOT-code is discarded.\n"
+         "The report shows the number of processed bytes, the wall- and CPU-time\n"
+         "of each stage in milliseconds and the throughput.\n\n"
+         "Example: Benchmark of 100 files with 50 states each by the built-in\n"
+         "preprocessor:\n" +
+         std::string( ppArgv[0] ) + " --gen-files 100 --gen-states 50 --cpp internal" );
+
+      if( oCommandlineParser() < 0 )
+         return oCommandlineParser.isFinished()? EXIT_SUCCESS : EXIT_FAILURE;
+
+      if( oKeywordPool.setDefaultsIfEmpty() )
+         return EXIT_FAILURE;
+
+      /*
+       * Without source-files on the command line a synthetic corpus
+       * becomes generated.
+       */
+      FsmGenerator::FILE_NAME_LIST_T files = oCommandlineParser.getFileNameList();
+      std::string tempDirectory;
+      if( files.empty() )
+      {
+         std::string directory = generator.getDirectory();
+         if( directory.empty() )
+         {
+            char name[] = "/tmp/docfsm_bench.XXXXXX";
+            if( ::mkdtemp( name ) == nullptr )
+            {
+               ERROR_MESSAGE( "Unable to create temporary directory!" );
+               return EXIT_FAILURE;
+            }
+            directory = tempDirectory = name;
+         }
+         if( generator.generate( directory, files ) )
+         {
+            if( !tempDirectory.empty() )
+               removeGenerated( tempDirectory, files );
+            return EXIT_FAILURE;
+         }
+      }
+
+      StopWatch   watches[STAGES];
+      std::size_t sourceBytes = 0;
+      std::size_t preprocessedBytes = 0;
+      std::size_t preparsedBytes = 0;
+      bool error = false;
+
+      for( auto& fileName : files )
+      {
+         sourceBytes += fileSize( fileName );
+
+         cppOutput.clear();
+         watches[CPP].start();
+         error = cppCaller.preprocess( fileName );
+         watches[CPP].stop();
+         if( error )
+            break;
+         preprocessedBytes += cppOutput.size();
+
+         watches[PREPARSE].start();
+         Preparser preparser( cppOutput, out );
+         error = preparser();
+         watches[PREPARSE].stop();
+         if( error )
+            break;
+         preparsedBytes += out.size();
+
+         transitionFinder.resetContext();
+         watches[COLLECT].start();
+         error = collector( fileName );
+         watches[COLLECT].stop();
+         if( error )
+            break;
+
+         if( collector.isEmpty() )
+            continue;
+
+         watches[TRANSITIONS].start();
+         error = transitionFinder();
+         watches[TRANSITIONS].stop();
+         if( error )
+            break;
+      }
+
+      if( !tempDirectory.empty() )
+         removeGenerated( tempDirectory, files );
+
+      if( error )
+         return EXIT_FAILURE;
+
+      watches[CLUSTERING].start();
+      collector.splitInClusters();
+      collector.splitInGroups();
+      collector.generateTooltipFromLabel();
+      watches[CLUSTERING].stop();
+
+      /*
+       * The DOT-output becomes written in the null-device, so only
+       * the costs of generating and writing remain.
+       */
+      int nullFd = ::open( "/dev/null", O_WRONLY );
+      if( nullFd < 0 )
+      {
+         ERROR_MESSAGE( "Unable to open /dev/null!" );
+         return EXIT_FAILURE;
+      }
+      DotWriter dotWriter( nullFd );
+      watches[PRINT].start();
+      collector.print( dotWriter );
+      error = dotWriter.close();
+      watches[PRINT].stop();
+      ::close( nullFd );
+      if( error )
+         return EXIT_FAILURE;
+
+      report( std::cout, watches, files.size(), sourceBytes,
+              preprocessedBytes, preparsedBytes, dotWriter.getBytes() );
+   }
+   catch( ... )
+   {
+      ERROR_MESSAGE( "Exception: perhaps not enough memory!" );
+      return EXIT_FAILURE;
+   }
+   return EXIT_SUCCESS;
+}
+
+//================================== EOF ======================================
@@ -32,32 +32,42 @@ CommandlineParser::OptPrintHelp::OptPrintHelp( void )
 */
 int CommandlineParser::OptPrintHelp::onGiven( PARSER* poParser )
 {
-   std::cout << "\nDocFsm is a documentation and reverse engineering tool for graphical presentation of\n"
+   CommandlineParser* poCommandlineParser = static_cast<CommandlineParser*>(poParser);
+   std::ostream& rOut = poCommandlineParser->getOut();
+
+   if( !poCommandlineParser->m_usage.empty() )
+   {
+      rOut << "\n" << poCommandlineParser->m_usage << "\n\nOptions:\n";
+      poParser->list( rOut );
+      rOut << std::endl;
+      return poCommandlineParser->finish();
+   }
+
+   rOut << "\nDocFsm is a documentation and reverse engineering tool for graphical presentation of\n"
                 "finite state machines (FSM) from C and/or C++ sourcefiles.\n\n";
-   std::cout << "It translates C/C++ sourcefiles containing a FSM - respectively containing\n"
+   rOut << "It translates C/C++ sourcefiles containing a FSM - respectively containing\n"
                 "for the FSM defined macros - into the DOT-language.\n\n";
-   std::cout << "(c) 2017 - 2020 Ulrich Becker\n\n"; 
-   std::cout << "Usage: " << poParser->getProgramName() << " [options,...] <C/C++ sourcefile [C/C++ sourcefile ...]>\n\n";
+   rOut << "(c) 2017 - 2020 Ulrich Becker\n\n"; 
+   rOut << "Usage: " << poParser->getProgramName() << " [options,...] <C/C++ sourcefile [C/C++ sourcefile ...]>\n\n";
 
-   std::cout << "Example 1: Creating a dot-file from a C sourcefile:\n";
-   std::cout << poParser->getProgramName() <<
+   rOut << "Example 1: Creating a dot-file from a C sourcefile:\n";
+   rOut << poParser->getProgramName() <<
                 " myFsm.c > myFsm.gv\n\n";
 
-   std::cout << "Example 2: Creating a PDF from a C++11 sourcefile with blue and thick transitions:\n";
-   std::cout << poParser->getProgramName() <<
+   rOut << "Example 2: Creating a PDF from a C++11 sourcefile with blue and thick transitions:\n";
+   rOut << poParser->getProgramName() <<
                 " -E style=bold -E color=blue"
                 " --std c++11 -I /path/to/my/additional/headers myFsm.cpp"
                 " | dot -Tpdf -o myFsm.pdf\n\n";
 
-   std::cout << "Example 3: Displaying directly from source file via Image Magick:\n";
-   std::cout << poParser->getProgramName() <<
+   rOut << "Example 3: Displaying directly from source file via Image Magick:\n";
+   rOut << poParser->getProgramName() <<
                 " myFsm.cpp | display\n\n";
 
-   std::cout << "Options:\n";
-   poParser->list( std::cout );
-   std::cout << std::endl;
-   ::exit( EXIT_SUCCESS );
-   return 0;
+   rOut << "Options:\n";
+   poParser->list( rOut );
+   rOut << std::endl;
+   return static_cast<CommandlineParser*>(poParser)->finish();
 }
 
 #ifdef CONFIG_GSI_AUTODOC_OPTION
@@ -75,8 +85,9 @@ CommandlineParser::OptGsiAutodoc::OptGsiAutodoc( void )
 */
 int CommandlineParser::OptGsiAutodoc::onGiven( PARSER* poParser )
 {
+   std::ostream& rOut = static_cast<CommandlineParser*>(poParser)->getOut();
    std::string name = poParser->getProgramName().substr(poParser->getProgramName().find_last_of('/')+1);
-   std::cout 
+   rOut 
    << "<toolinfo>\n"
       "\t<name>" << name << "</name>\n"
       "\t<topic>Development, Release, Rollout</topic>\n"
@@ -88,38 +99,38 @@ int CommandlineParser::OptGsiAutodoc::onGiven( PARSER* poParser )
       {
          if( pOption == this )
             continue;
-         std::cout << " [";
+         rOut << " [";
          if( pOption->m_shortOpt != '\0' )
          {
-            std::cout << '-' << pOption->m_shortOpt;
+            rOut << '-' << pOption->m_shortOpt;
             if( pOption->m_hasArg != OPTION::NO_ARG )
             {
-               std::cout << ' ';
+               rOut << ' ';
             #ifndef CONFIG_CLOP_NO_OPTIONAL_ARG
                if( pOption->m_hasArg == OPTION::OPTIONAL_ARG )
-                  std::cout << '=';
+                  rOut << '=';
             #endif
-               std::cout << "ARG";
+               rOut << "ARG";
             }
             if( !pOption->m_longOpt.empty() )
-               std::cout << ", ";
+               rOut << ", ";
          }
          if( !pOption->m_longOpt.empty() )
          {
-            std::cout << "--" << pOption->m_longOpt;
+            rOut << "--" << pOption->m_longOpt;
             if( pOption->m_hasArg != OPTION::NO_ARG )
             {
-               std::cout << ' ';
+               rOut << ' ';
             #ifndef CONFIG_CLOP_NO_OPTIONAL_ARG
                if( pOption->m_hasArg == OPTION::OPTIONAL_ARG )
-                   std::cout << '=';
+                   rOut << '=';
             #endif
-               std::cout << "ARG";
+               rOut << "ARG";
             }
          }
-         std::cout << ']';
+         rOut << ']';
       }
-      std::cout << " {soucefile(s)}\n\t</usage>\n"
+      rOut << " {soucefile(s)}\n\t</usage>\n"
       "\t<author>Ulrich Becker</author>\n"
       "\t<tags>graphics</tags>\n"
       "\t<version>" DOCFSM_VERSION "</version>\n"
@@ -128,8 +139,7 @@ int CommandlineParser::OptGsiAutodoc::onGiven( PARSER* poParser )
       "\t<requires>Graphviz and/or Image Magick</requires>\n"
       "\t<autodocversion>1.0</autodocversion>\n"
    "</toolinfo>" << std::endl;
-   ::exit( EXIT_SUCCESS );
-   return 0;
+   return static_cast<CommandlineParser*>(poParser)->finish();
 }
 #endif // ifdef CONFIG_GSI_AUTODOC_OPTION
 
@@ -170,9 +180,8 @@ int CommandlineParser::OptVersion::onGiven( PARSER* poParser )
 #else
   #define VERSION_STRING  DOCFSM_VERSION " Release"
 #endif
-   std::cout << VERSION_STRING << std::endl;
-   ::exit( EXIT_SUCCESS );
-   return 0;
+   static_cast<CommandlineParser*>(poParser)->getOut() << VERSION_STRING << std::endl;
+   return static_cast<CommandlineParser*>(poParser)->finish();
 }
 
 /*!----------------------------------------------------------------------------
@@ -182,7 +191,6 @@ int CommandlineParser::onArgument( void )
    if( ::access( getArgVect()[getArgIndex()], F_OK ) != 0 )
    {
       ERROR_MESSAGE( "File: \"" << getArgVect()[getArgIndex()] << "\" not found!" );
-      ::exit( EXIT_FAILURE );
       return -1;
    }
    m_vSourceFiles.push_back( getArgVect()[getArgIndex()] );
@@ -67,11 +67,20 @@ class CommandlineParser: public CLOP::PARSER
 
    FILE_NAME_LIST_T m_vSourceFiles;
    bool             m_verbose;
+   bool             m_finished;
+   std::ostream&    m_rOut;
+   std::string      m_usage;
 
 public:
-   CommandlineParser( int argc, char** ppArgv )
+   /*!
+    * @param rOut Stream for the output of the information options
+    *             like "--help".
+    */
+   CommandlineParser( int argc, char** ppArgv, std::ostream& rOut = std::cout )
       :PARSER( argc, ppArgv )
       ,m_verbose(false)
+      ,m_finished(false)
+      ,m_rOut( rOut )
    {
       add( m_optPrintHelp )
 #ifdef CONFIG_GSI_AUTODOC_OPTION
@@ -91,6 +100,41 @@ public:
    {
       return m_verbose;
    }
+
+   /*!
+    * @brief Replaces the description and the examples of DocFsm in the
+    *        output of "--help" by the given text, e.g. for further
+    *        programs like the benchmark.
+    */
+   void setUsage( const std::string& rUsage )
+   {
+      m_usage = rUsage;
+   }
+
+   std::ostream& getOut( void )
+   {
+      return m_rOut;
+   }
+
+   /*!
+    * @brief Stops the parsing after a information option like "--help"
+    *        has been handled, so there is nothing more to do.
+    * @return Value for returning from onGiven(), which stops the parsing.
+    */
+   int finish( void )
+   {
+      m_finished = true;
+      return -1;
+   }
+
+   /*!
+    * @brief Returns true when the parsing has been stopped by finish(),
+    *        so a negative result of the parsing is not a error.
+    */
+   bool isFinished( void ) const
+   {
+      return m_finished;
+   }
 };
 
 } // End namespace DocFsm
@@ -0,0 +1,490 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!  @brief Module reads the preprocessor flags of each source-file from a   */
+/*!         compilation database "compile_commands.json".                    */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_compdb.cpp                                                   */
+/*! @see     df_compdb.hpp                                                   */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <ctype.h>
+#include <fstream>
+#include <sstream>
+
+#include "df_docfsm.hpp"
+#include "df_compdb.hpp"
+
+using namespace DocFsm;
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Reads the JSON-values of a compilation database.
+ *
+ * All functions returning bool return true in the case of a syntax error.
+ */
+class CompilationDatabase::Reader
+{
+   const std::string&  m_rText;
+   std::size_t         m_pos;
+
+public:
+   Reader( const std::string& rText )
+      :m_rText( rText )
+      ,m_pos( 0 )
+   {}
+
+   std::size_t getPosition( void ) const { return m_pos; }
+
+   /*!
+    * @brief Consumes the given character if it is the next one
+    *        after white spaces.
+    * @retval true Character consumed.
+    */
+   bool accept( char c )
+   {
+      skipSpace();
+      if( (m_pos < m_rText.size()) && (m_rText[m_pos] == c) )
+      {
+         m_pos++;
+         return true;
+      }
+      return false;
+   }
+
+   bool expect( char c ) { return !accept( c ); }
+
+   bool getString( std::string& rStr );
+   bool getStringArray( FLAG_LIST_T& rList );
+   bool skipValue( void );
+
+private:
+   void skipSpace( void )
+   {
+      while( (m_pos < m_rText.size()) && ::isspace( m_rText[m_pos] ) )
+         m_pos++;
+   }
+   void addUtf8( std::string& rStr, unsigned long codePoint );
+   bool getHex4( unsigned long& rValue );
+};
+
+/*!----------------------------------------------------------------------------
+*/
+bool CompilationDatabase::Reader::getString( std::string& rStr )
+{
+   if( expect( '"' ) )
+      return true;
+   rStr.clear();
+   while( m_pos < m_rText.size() )
+   {
+      const char c = m_rText[m_pos++];
+      if( c == '"' )
+         return false;
+      if( c != '\\' )
+      {
+         rStr += c;
+         continue;
+      }
+      if( m_pos >= m_rText.size() )
+         return true;
+      switch( m_rText[m_pos++] )
+      {
+         case '"':  rStr += '"';  break;
+         case '\\': rStr += '\\'; break;
+         case '/':  rStr += '/';  break;
+         case 'b':  rStr += '\b'; break;
+         case 'f':  rStr += '\f'; break;
+         case 'n':  rStr += '\n'; break;
+         case 'r':  rStr += '\r'; break;
+         case 't':  rStr += '\t'; break;
+         case 'u':
+         {
+            unsigned long codePoint;
+            if( getHex4( codePoint ) )
+               return true;
+            if( (codePoint >= 0xD800) && (codePoint < 0xDC00) &&
+                (m_rText.compare( m_pos, 2, "\\u" ) == 0) )
+            { // Surrogate pair
+               m_pos += 2;
+               unsigned long low;
+               if( getHex4( low ) )
+                  return true;
+               codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+            }
+            addUtf8( rStr, codePoint );
+            break;
+         }
+         default: return true;
+      }
+   }
+   return true;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool CompilationDatabase::Reader::getHex4( unsigned long& rValue )
+{
+   if( m_pos + 4 > m_rText.size() )
+      return true;
+   rValue = 0;
+   for( int i = 0; i < 4; i++ )
+   {
+      const char c = m_rText[m_pos++];
+      if( !::isxdigit( c ) )
+         return true;
+      rValue = (rValue << 4) | (::isdigit( c )? (c - '0') : (::tolower( c ) - 'a' + 10));
+   }
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void CompilationDatabase::Reader::addUtf8( std::string& rStr, unsigned long codePoint )
+{
+   if( codePoint < 0x80 )
+   {
+      rStr += static_cast<char>( codePoint );
+   }
+   else if( codePoint < 0x800 )
+   {
+      rStr += static_cast<char>( 0xC0 | (codePoint >> 6) );
+      rStr += static_cast<char>( 0x80 | (codePoint & 0x3F) );
+   }
+   else if( codePoint < 0x10000 )
+   {
+      rStr += static_cast<char>( 0xE0 | (codePoint >> 12) );
+      rStr += static_cast<char>( 0x80 | ((codePoint >> 6) & 0x3F) );
+      rStr += static_cast<char>( 0x80 | (codePoint & 0x3F) );
+   }
+   else
+   {
+      rStr += static_cast<char>( 0xF0 | (codePoint >> 18) );
+      rStr += static_cast<char>( 0x80 | ((codePoint >> 12) & 0x3F) );
+      rStr += static_cast<char>( 0x80 | ((codePoint >> 6) & 0x3F) );
+      rStr += static_cast<char>( 0x80 | (codePoint & 0x3F) );
+   }
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool CompilationDatabase::Reader::getStringArray( FLAG_LIST_T& rList )
+{
+   if( expect( '[' ) )
+      return true;
+   if( accept( ']' ) )
+      return false;
+   do
+   {
+      std::string str;
+      if( getString( str ) )
+         return true;
+      rList.push_back( str );
+   }
+   while( accept( ',' ) );
+   return expect( ']' );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool CompilationDatabase::Reader::skipValue( void )
+{
+   skipSpace();
+   if( m_pos >= m_rText.size() )
+      return true;
+
+   std::string str;
+   switch( m_rText[m_pos] )
+   {
+      case '"': return getString( str );
+      case '[':
+      {
+         m_pos++;
+         if( accept( ']' ) )
+            return false;
+         do
+         {
+            if( skipValue() )
+               return true;
+         }
+         while( accept( ',' ) );
+         return expect( ']' );
+      }
+      case '{':
+      {
+         m_pos++;
+         if( accept( '}' ) )
+            return false;
+         do
+         {
+            if( getString( str ) || expect( ':' ) || skipValue() )
+               return true;
+         }
+         while( accept( ',' ) );
+         return expect( '}' );
+      }
+   }
+
+   // Number, true, false or null
+   const std::size_t start = m_pos;
+   while( (m_pos < m_rText.size()) &&
+          (::isalnum( m_rText[m_pos] ) || (m_rText[m_pos] == '+') ||
+           (m_rText[m_pos] == '-') || (m_rText[m_pos] == '.')) )
+      m_pos++;
+   return m_pos == start;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+CompilationDatabase::OptionCompdb::OptionCompdb( CompilationDatabase* pParent )
+   :m_pParent( pParent )
+{
+   m_hasArg   = REQUIRED_ARG;
+   m_shortOpt = '\0';
+   m_longOpt  = "compdb";
+   m_helpText = "Takes the preprocessor flags \"-I\", \"-isystem\", \"-iquote\",\n"
+                "\"-D\", \"-U\" and \"-std=\" of each source-file from the\n"
+                "compilation database PARAM. They become appended to the\n"
+                "flags given on the command line.\n"
+                "E.g.: --compdb build/compile_commands.json";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int CompilationDatabase::OptionCompdb::onGiven( CLOP::PARSER* poParser )
+{
+   if( m_pParent->load( poParser->getOptArg() ) )
+   {
+      return -1;
+   }
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+CompilationDatabase::CompilationDatabase( CommandlineParser& rParser )
+   :m_oOptionCompdb( this )
+{
+   rParser( m_oOptionCompdb );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool CompilationDatabase::load( const std::string& rFileName )
+{
+   std::ifstream file( rFileName.c_str() );
+   if( !file )
+   {
+      ERROR_MESSAGE( "Can't open compilation database \"" << rFileName << "\"!" );
+      return true;
+   }
+   std::stringstream content;
+   content << file.rdbuf();
+   const std::string text = content.str();
+
+   Reader reader( text );
+   bool error = reader.expect( '[' );
+   if( !error && !reader.accept( ']' ) )
+   {
+      do
+      {
+         std::string directory;
+         std::string fileName;
+         std::string command;
+         FLAG_LIST_T arguments;
+         bool haveArguments = false;
+
+         error = reader.expect( '{' );
+         if( error )
+            break;
+         if( !reader.accept( '}' ) )
+         {
+            do
+            {
+               std::string key;
+               error = reader.getString( key ) || reader.expect( ':' );
+               if( error )
+                  break;
+               if( key == "directory" )
+                  error = reader.getString( directory );
+               else if( key == "file" )
+                  error = reader.getString( fileName );
+               else if( key == "command" )
+                  error = reader.getString( command );
+               else if( key == "arguments" )
+               {
+                  error = reader.getStringArray( arguments );
+                  haveArguments = true;
+               }
+               else
+                  error = reader.skipValue();
+               if( error )
+                  break;
+            }
+            while( reader.accept( ',' ) );
+            if( error || (error = reader.expect( '}' )) )
+               break;
+         }
+
+         if( !haveArguments )
+            splitCommand( command, arguments );
+         if( !fileName.empty() )
+            addEntry( directory, fileName, arguments );
+      }
+      while( reader.accept( ',' ) );
+      if( !error )
+         error = reader.expect( ']' );
+   }
+
+   if( error )
+   {
+      ERROR_MESSAGE( "Syntax error in compilation database \"" << rFileName
+                     << "\" at offset " << reader.getPosition() << "!" );
+      return true;
+   }
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void CompilationDatabase::addEntry( const std::string& rDirectory,
+                                    const std::string& rFile,
+                                    const FLAG_LIST_T& rArguments )
+{
+   const std::string path = realPath( makePath( rDirectory, rFile ) );
+   if( m_files.count( path ) != 0 )
+      return; // The first entry of a file counts.
+   FLAG_LIST_T& rFlags = m_files[path];
+
+   static const char* const c_pathFlags[] = { "-I", "-isystem", "-iquote" };
+   static const char* const c_flags[] = { "-D", "-U" };
+
+   /*
+    * The first argument is the compiler itself.
+    */
+   for( std::size_t i = 1; i < rArguments.size(); i++ )
+   {
+      const std::string& rArg = rArguments[i];
+
+      if( rArg.compare( 0, 5, "-std=" ) == 0 )
+      {
+         rFlags.push_back( rArg );
+         continue;
+      }
+
+      bool found = false;
+      for( const auto& pFlag : c_pathFlags )
+      {
+         const std::size_t len = ::strlen( pFlag );
+         if( rArg.compare( 0, len, pFlag ) != 0 )
+            continue;
+         found = true;
+         std::string value = rArg.substr( len );
+         if( value.empty() && (i + 1 < rArguments.size()) )
+            value = rArguments[++i];
+         if( !value.empty() )
+            rFlags.push_back( pFlag + makePath( rDirectory, value ) );
+         break;
+      }
+      if( found )
+         continue;
+
+      for( const auto& pFlag : c_flags )
+      {
+         if( rArg.compare( 0, 2, pFlag ) != 0 )
+            continue;
+         std::string value = rArg.substr( 2 );
+         if( value.empty() && (i + 1 < rArguments.size()) )
+            value = rArguments[++i];
+         if( !value.empty() )
+            rFlags.push_back( pFlag + value );
+         break;
+      }
+   }
+}
+
+/*!----------------------------------------------------------------------------
+*/
+const CompilationDatabase::FLAG_LIST_T*
+CompilationDatabase::find( const std::string& rFileName ) const
+{
+   if( m_files.empty() )
+      return nullptr;
+   const auto it = m_files.find( realPath( rFileName ) );
+   if( it == m_files.end() )
+      return nullptr;
+   return &it->second;
+}
+
+/*!----------------------------------------------------------------------------
+ * Splits the command string like a shell would do, respecting quotes and
+ * backslashes.
+ */
+void CompilationDatabase::splitCommand( const std::string& rCommand,
+                                        FLAG_LIST_T& rArguments )
+{
+   std::string arg;
+   bool inArg = false;
+   char quote = '\0';
+   for( std::size_t i = 0; i < rCommand.size(); i++ )
+   {
+      const char c = rCommand[i];
+      if( quote != '\0' )
+      {
+         if( c == quote )
+            quote = '\0';
+         else if( (c == '\\') && (quote == '"') && (i + 1 < rCommand.size()) )
+            arg += rCommand[++i];
+         else
+            arg += c;
+         continue;
+      }
+      if( ::isspace( c ) )
+      {
+         if( inArg )
+            rArguments.push_back( arg );
+         arg.clear();
+         inArg = false;
+         continue;
+      }
+      inArg = true;
+      if( (c == '"') || (c == '\'') )
+         quote = c;
+      else if( (c == '\\') && (i + 1 < rCommand.size()) )
+         arg += rCommand[++i];
+      else
+         arg += c;
+   }
+   if( inArg )
+      rArguments.push_back( arg );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+std::string CompilationDatabase::makePath( const std::string& rDirectory,
+                                           const std::string& rName )
+{
+   if( rName.empty() || (rName[0] == '/') || rDirectory.empty() )
+      return rName;
+   if( rDirectory.back() == '/' )
+      return rDirectory + rName;
+   return rDirectory + '/' + rName;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+std::string CompilationDatabase::realPath( const std::string& rName )
+{
+   char path[PATH_MAX];
+   if( ::realpath( rName.c_str(), path ) == nullptr )
+      return rName;
+   return path;
+}
+
+//================================== EOF ======================================
@@ -0,0 +1,88 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!  @brief Module reads the preprocessor flags of each source-file from a   */
+/*!         compilation database "compile_commands.json".                    */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_compdb.hpp                                                   */
+/*! @see     df_compdb.cpp                                                   */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#ifndef _DF_COMPDB_HPP
+#define _DF_COMPDB_HPP
+
+#ifndef __DOCFSM__
+ #include <string>
+ #include <vector>
+ #include <unordered_map>
+ #include "df_commandline.hpp"
+#endif
+
+namespace DocFsm
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Compilation database given by the option "--compdb", as generated
+ *        e.g. by CMake with CMAKE_EXPORT_COMPILE_COMMANDS.
+ *
+ * Of each compile command the flags which influence the preprocessor
+ * become taken: "-I", "-isystem", "-iquote", "-D", "-U" and "-std=".
+ * Relative include directories become completed by the directory of the
+ * entry, so the preprocessor can run in any working directory.
+ */
+class CompilationDatabase
+{
+public:
+   using FLAG_LIST_T = std::vector<std::string>;
+
+private:
+   class OptionCompdb: public CLOP::OPTION_V
+   {
+      CompilationDatabase*   m_pParent;
+   public:
+      OptionCompdb( CompilationDatabase* pParent );
+      int onGiven( CLOP::PARSER* poParser ) override;
+   };
+
+   class Reader;
+
+   /*!
+    * @brief Real path of the source-file to its preprocessor flags.
+    */
+   using FILE_MAP_T = std::unordered_map<std::string, FLAG_LIST_T>;
+
+   OptionCompdb   m_oOptionCompdb;
+   FILE_MAP_T     m_files;
+
+public:
+   CompilationDatabase( CommandlineParser& rParser );
+
+   bool isActive( void ) const { return !m_files.empty(); }
+
+   /*!
+    * @brief Reads the given compilation database.
+    * @retval true Error
+    */
+   bool load( const std::string& rFileName );
+
+   /*!
+    * @brief Returns the preprocessor flags of the given source-file or
+    *        nullptr if the file is not contained in the database.
+    */
+   const FLAG_LIST_T* find( const std::string& rFileName ) const;
+
+private:
+   void addEntry( const std::string& rDirectory, const std::string& rFile,
+                  const FLAG_LIST_T& rArguments );
+   static void splitCommand( const std::string& rCommand, FLAG_LIST_T& rArguments );
+   static std::string makePath( const std::string& rDirectory,
+                                const std::string& rName );
+   static std::string realPath( const std::string& rName );
+};
+
+} // End namespace DocFsm
+#endif // ifndef _DF_COMPDB_HPP
+//================================== EOF ======================================
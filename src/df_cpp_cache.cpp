@@ -0,0 +1,315 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!  @brief Module stores the output of the preprocessor in a cache-         */
+/*!         directory, so unchanged files needn't preprocessed again.        */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_cpp_cache.cpp                                                */
+/*! @see     df_cpp_cache.hpp                                                */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#ifndef __DOCFSM__
+ #include <fstream>
+ #include <unistd.h>
+ #include <limits.h>
+ #include <stdlib.h>
+ #include <stdio.h>
+ #include <sys/stat.h>
+#endif
+#include "df_docfsm.hpp"
+#include "df_hash.hpp"
+#include "df_cpp_cache.hpp"
+
+using namespace DocFsm;
+
+/*!
+ * @brief Has to be incremented when the format of a cache-entry changes.
+ */
+#define CPP_CACHE_FORMAT_VERSION 1
+
+static const char c_cppCacheMagic[] = "DFPC";
+
+/*!----------------------------------------------------------------------------
+ * @brief Delivers the line beginning at rPos without the newline and sets
+ *        rPos behind it.
+ * @retval true No complete line left.
+ */
+static bool getLine( const std::string& rData, std::size_t& rPos,
+                     std::string& rLine )
+{
+   const std::size_t end = rData.find( '\n', rPos );
+   if( end == std::string::npos )
+      return true;
+   rLine.assign( rData, rPos, end - rPos );
+   rPos = end + 1;
+   return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+CppCache::OptionCppCache::OptionCppCache( CppCache* pParent )
+   :m_pParent( pParent )
+{
+   m_hasArg   = REQUIRED_ARG;
+   m_shortOpt = '\0';
+   m_longOpt  = "cpp-cache";
+   m_helpText = "Stores the output of the preprocessor for each source-file\n"
+                "in the directory PARAM. In a further run the preprocessor\n"
+                "becomes not invoked for files which are unchanged, including\n"
+                "all files included by them, and which are preprocessed with\n"
+                "the same options.\n"
+                "The directory becomes created if not present.\n"
+                "E.g.: --cpp-cache ~/.cache/docfsm";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int CppCache::OptionCppCache::onGiven( CLOP::PARSER* poParser )
+{
+   const std::string& rDir = poParser->getOptArg();
+   struct stat status;
+
+   if( rDir.empty() )
+   {
+      ERROR_MESSAGE( "Missing directory for the preprocessor cache!" );
+      return -1;
+   }
+
+   if( ::stat( rDir.c_str(), &status ) != 0 )
+   {
+      if( ::mkdir( rDir.c_str(), 0777 ) != 0 )
+      {
+         ERROR_MESSAGE( "Unable to create cache-directory \"" << rDir << "\"!" );
+         return -1;
+      }
+   }
+   else if( !S_ISDIR( status.st_mode ) )
+   {
+      ERROR_MESSAGE( "\"" << rDir << "\" is not a directory!" );
+      return -1;
+   }
+
+   m_pParent->m_dir = rDir;
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+CppCache::CppCache( CommandlineParser& rParser )
+   :m_oOptionCppCache( this )
+{
+   rParser( m_oOptionCppCache );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool CppCache::readFile( const std::string& rName, std::string& rContent )
+{
+   std::ifstream file( rName.c_str(), std::ios::in | std::ios::binary );
+   if( !file )
+      return true;
+   file.seekg( 0, std::ios::end );
+   const std::streamoff size = file.tellg();
+   if( size < 0 )
+      return true;
+   rContent.resize( size );
+   file.seekg( 0, std::ios::beg );
+   file.read( &rContent[0], rContent.size() );
+   return !file;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool CppCache::hashFile( const std::string& rName, uint64_t& rHash )
+{
+   std::string content;
+   if( readFile( rName, content ) )
+      return true;
+   Hash hash;
+   hash.add( content );
+   rHash = hash();
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool CppCache::makeKey( const std::string& rFilename, const std::string& rExe,
+                        const FILE_LIST_T& rOptions, uint64_t& rKey ) const
+{
+   uint64_t sourceHash;
+   if( hashFile( rFilename, sourceHash ) )
+      return true;
+
+   Hash hash;
+   hash.add( std::string( c_cppCacheMagic ) + DOCFSM_VERSION );
+   hash.add( CPP_CACHE_FORMAT_VERSION );
+   hash.add( sourceHash );
+   hash.add( rFilename );
+
+   /*
+    * Relative names of the source-file and of the include-directories
+    * depend on the working directory.
+    */
+   char cwd[PATH_MAX];
+   if( ::getcwd( cwd, sizeof( cwd ) ) == nullptr )
+      return true;
+   hash.add( std::string( cwd ) );
+
+   /*
+    * A update of the external preprocessor could change its output.
+    */
+   hash.add( rExe );
+   if( !rExe.empty() )
+   {
+      struct stat status;
+      if( ::stat( rExe.substr( 0, rExe.find( ' ' ) ).c_str(), &status ) != 0 )
+         return true;
+      hash.add( static_cast<uint64_t>( status.st_size ) );
+      hash.add( static_cast<uint64_t>( status.st_mtime ) );
+   }
+
+   hash.add( rOptions.size() );
+   for( const auto& rOption : rOptions )
+      hash.add( rOption );
+
+   rKey = hash();
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+std::string CppCache::entryFileName( uint64_t key ) const
+{
+   char name[sizeof( key ) * 2 + 1];
+   ::snprintf( name, sizeof( name ), "%016llx",
+               static_cast<unsigned long long>( key ) );
+   return m_dir + '/' + name + ".dfp";
+}
+
+/*!----------------------------------------------------------------------------
+ * Format of a entry:
+ * @code
+ * DFPC <format version>
+ * <key>
+ * <number of files>
+ * <hash of file> <name of file>
+ * ...
+ * <size of diagnostics> <size of output>
+ * <diagnostics><output>
+ * @endcode
+ */
+bool CppCache::load( uint64_t key, std::string& rOutput,
+                     std::string& rDiagnostics ) const
+{
+   std::string data;
+   if( readFile( entryFileName( key ), data ) )
+      return false;
+
+   std::size_t pos = 0;
+   std::string line;
+   if( getLine( data, pos, line ) ||
+       (line != std::string( c_cppCacheMagic ) + ' ' +
+                std::to_string( CPP_CACHE_FORMAT_VERSION )) )
+      return false;
+
+   if( getLine( data, pos, line ) || (::strtoull( line.c_str(), nullptr, 16 ) != key) )
+      return false;
+
+   if( getLine( data, pos, line ) )
+      return false;
+   const unsigned long count = ::strtoul( line.c_str(), nullptr, 10 );
+   for( unsigned long i = 0; i < count; i++ )
+   {
+      if( getLine( data, pos, line ) )
+         return false;
+      const std::size_t separator = line.find( ' ' );
+      if( separator == std::string::npos )
+         return false;
+      uint64_t hash;
+      if( hashFile( line.substr( separator + 1 ), hash ) ||
+          (::strtoull( line.c_str(), nullptr, 16 ) != hash) )
+         return false;
+   }
+
+   if( getLine( data, pos, line ) )
+      return false;
+   char* pEnd;
+   const std::size_t diagnosticsSize = ::strtoull( line.c_str(), &pEnd, 10 );
+   const std::size_t outputSize = ::strtoull( pEnd, nullptr, 10 );
+   if( data.size() - pos != diagnosticsSize + outputSize )
+      return false;
+
+   rDiagnostics.assign( data, pos, diagnosticsSize );
+   rOutput.append( data, pos + diagnosticsSize, outputSize );
+   return true;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void CppCache::store( uint64_t key, const FILE_LIST_T& rFiles,
+                      const char* pOutput, std::size_t size,
+                      const std::string& rDiagnostics ) const
+{
+   std::string header = std::string( c_cppCacheMagic ) + ' ' +
+                        std::to_string( CPP_CACHE_FORMAT_VERSION ) + '\n';
+   char number[sizeof( key ) * 2 + 2];
+   ::snprintf( number, sizeof( number ), "%016llx\n",
+               static_cast<unsigned long long>( key ) );
+   header += number;
+   header += std::to_string( rFiles.size() ) + '\n';
+   for( const auto& rFile : rFiles )
+   {
+      uint64_t hash;
+      if( (rFile.find( '\n' ) != std::string::npos) || hashFile( rFile, hash ) )
+         return;
+      ::snprintf( number, sizeof( number ), "%016llx",
+                  static_cast<unsigned long long>( hash ) );
+      header += std::string( number ) + ' ' + rFile + '\n';
+   }
+   header += std::to_string( rDiagnostics.size() ) + ' ' +
+             std::to_string( size ) + '\n';
+
+   /*
+    * Writing in a temporary file followed by renaming, so a concurrent
+    * running DocFsm respectively worker thread will never see an
+    * incomplete entry.
+    */
+   const std::string fileName = entryFileName( key );
+   std::string tempName;
+   if( makeTempFile( tempName ) )
+      return;
+   std::ofstream file( tempName.c_str(), std::ios::out | std::ios::binary |
+                                         std::ios::trunc );
+   file.write( header.data(), header.size() );
+   file.write( rDiagnostics.data(), rDiagnostics.size() );
+   file.write( pOutput, size );
+   file.close();
+   if( !file || (::rename( tempName.c_str(), fileName.c_str() ) != 0) )
+   {
+      ::unlink( tempName.c_str() );
+      WARNING_MESSAGE( "Unable to write cache-entry \"" << fileName << "\"!" );
+   }
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool CppCache::makeTempFile( std::string& rName ) const
+{
+   std::string pattern = m_dir + "/tmp.XXXXXX";
+   const int fd = ::mkstemp( &pattern[0] );
+   if( fd < 0 )
+   {
+      WARNING_MESSAGE( "Unable to create a temporary file in \"" << m_dir
+                       << "\"!" );
+      return true;
+   }
+   ::close( fd );
+   rName = pattern;
+   return false;
+}
+
+//================================== EOF ======================================
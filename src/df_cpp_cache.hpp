@@ -0,0 +1,110 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!  @brief Module stores the output of the preprocessor in a cache-         */
+/*!         directory, so unchanged files needn't preprocessed again.        */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_cpp_cache.hpp                                                */
+/*! @see     df_cpp_cache.cpp                                                */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#ifndef _DF_CPP_CACHE_HPP
+#define _DF_CPP_CACHE_HPP
+
+#ifndef __DOCFSM__
+ #include <stdint.h>
+ #include <string>
+ #include <vector>
+ #include "df_commandline.hpp"
+#endif
+
+namespace DocFsm
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Cache of the preprocessed source-code given by the option
+ *        "--cpp-cache".
+ *
+ * The key of a cache-entry is a hash over the content of the source-file,
+ * its name, the working directory, the preprocessor and all its options.
+ * The entry contains the hashes of all files which the preprocessor has
+ * read, the source-file and the included ones. A hit requires that none
+ * of them has been changed, then the stored output becomes delivered
+ * without starting the preprocessor.
+ *
+ * Unlike the ModelCache the entries are independent of the keywords and
+ * of the options for the DOT-output, so changing them still reuses the
+ * preprocessed source-code.
+ *
+ * All functions are const, so the worker threads of the PreprocessPool
+ * can use the same object concurrently.
+ */
+class CppCache
+{
+public:
+   using FILE_LIST_T = std::vector<std::string>;
+
+private:
+   class OptionCppCache: public CLOP::OPTION_V
+   {
+      CppCache*   m_pParent;
+   public:
+      OptionCppCache( CppCache* pParent );
+      int onGiven( CLOP::PARSER* poParser ) override;
+   };
+
+   OptionCppCache   m_oOptionCppCache;
+   std::string      m_dir;
+
+public:
+   CppCache( CommandlineParser& rParser );
+
+   bool isActive( void ) const { return !m_dir.empty(); }
+
+   /*!
+    * @brief Computes the key of the cache-entry for the given source-file.
+    * @param rFilename Name of the source-file.
+    * @param rExe      Preprocessor executable, empty for the built-in one.
+    * @param rOptions  Options of the preprocessor.
+    * @param rKey      Receives the key.
+    * @retval true Key not computable, e.g. source-file not readable.
+    */
+   bool makeKey( const std::string& rFilename, const std::string& rExe,
+                 const FILE_LIST_T& rOptions, uint64_t& rKey ) const;
+
+   /*!
+    * @brief Appends the cached output of the given key to rOutput if all
+    *        files of the entry are unchanged.
+    * @param rDiagnostics Receives the messages of the preprocessor of
+    *                     the stored run.
+    * @retval true Hit
+    */
+   bool load( uint64_t key, std::string& rOutput, std::string& rDiagnostics ) const;
+
+   /*!
+    * @brief Stores the output of a preprocessor run.
+    * @param rFiles All files read by the preprocessor.
+    */
+   void store( uint64_t key, const FILE_LIST_T& rFiles,
+               const char* pOutput, std::size_t size,
+               const std::string& rDiagnostics ) const;
+
+   /*!
+    * @brief Creates an empty temporary file in the cache-directory,
+    *        e.g. for the dependencies written by the preprocessor.
+    * @retval true Error
+    */
+   bool makeTempFile( std::string& rName ) const;
+
+private:
+   std::string entryFileName( uint64_t key ) const;
+   static bool readFile( const std::string& rName, std::string& rContent );
+   static bool hashFile( const std::string& rName, uint64_t& rHash );
+};
+
+} // End namespace DocFsm
+#endif // ifndef _DF_CPP_CACHE_HPP
+//================================== EOF ======================================
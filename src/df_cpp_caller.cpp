@@ -9,11 +9,189 @@
 /*! @date    17.12.2017                                                      */
 /*  Updates:                                                                 */
 /*****************************************************************************/
+#ifndef __DOCFSM__
+ #include <ctype.h>
+ #include <unistd.h>
+ #include <fstream>
+ #include <sstream>
+#endif
 #include "df_docfsm.hpp"
+#include "df_internal_cpp.hpp"
 #include "df_cpp_caller.hpp"
 
 using namespace DocFsm;
 
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+std::size_t CppExecution::addFileFlags( const std::string& rFilename )
+{
+   const std::size_t size = m_oOptionList.size();
+   if( m_pCompilationDb == nullptr )
+      return size;
+   const CompilationDatabase::FLAG_LIST_T* pFlags = m_pCompilationDb->find( rFilename );
+   if( pFlags != nullptr )
+      m_oOptionList.insert( m_oOptionList.end(), pFlags->begin(), pFlags->end() );
+   return size;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool CppExecution::preprocess( const std::string& rFilename )
+{
+   const std::size_t size = addFileFlags( rFilename );
+   bool ret;
+   uint64_t key;
+   if( (m_pCppCache != nullptr) && m_pCppCache->isActive() &&
+       !m_pCppCache->makeKey( rFilename, m_internal? std::string() : m_exe,
+                              m_oOptionList, key ) )
+      ret = executeCached( rFilename, key );
+   else
+      ret = execute( rFilename, nullptr );
+   m_oOptionList.resize( size );
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool CppExecution::preprocess( const std::string& rFilename,
+                               const std::string& rSource )
+{
+   const std::size_t size = addFileFlags( rFilename );
+   InternalCpp internalCpp( m_oOptionList, getStdBuffer(), getErrOstream() );
+   m_oOptionList.resize( size );
+   return internalCpp.run( rFilename, rSource );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool CppExecution::execute( const std::string& rFilename, FILE_LIST_T* pFiles )
+{
+   if( m_internal )
+   {
+      InternalCpp internalCpp( m_oOptionList, getStdBuffer(), getErrOstream() );
+      internalCpp.setFileList( pFiles );
+      return internalCpp( rFilename );
+   }
+
+   if( pFiles == nullptr )
+      return run( rFilename );
+
+   /*
+    * The external preprocessor writes the names of the read files as
+    * make-rule in a temporary file, additional to its normal output.
+    */
+   std::string dependencyFile;
+   if( m_pCppCache->makeTempFile( dependencyFile ) )
+      return run( rFilename );
+
+   const std::size_t size = m_oOptionList.size();
+   m_oOptionList.push_back( "-MD" );
+   m_oOptionList.push_back( "-MF" );
+   m_oOptionList.push_back( dependencyFile );
+   const bool ret = run( rFilename );
+   m_oOptionList.resize( size );
+
+   if( !ret )
+   {
+      std::ifstream file( dependencyFile.c_str() );
+      std::stringstream rule;
+      rule << file.rdbuf();
+      parseMakeRule( rule.str(), *pFiles );
+   }
+   ::unlink( dependencyFile.c_str() );
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool CppExecution::executeCached( const std::string& rFilename, uint64_t key )
+{
+   std::string& rOutput = getStdBuffer();
+   std::string diagnostics;
+   if( m_pCppCache->load( key, rOutput, diagnostics ) )
+   {
+      resetChildCpuTime();
+      getErrOstream() << diagnostics;
+      return false;
+   }
+
+   /*
+    * The messages of the preprocessor become recorded, so they can be
+    * repeated by a later hit.
+    */
+   const std::size_t begin = rOutput.size();
+   FILE_LIST_T files;
+   std::stringbuf errBuffer;
+   std::streambuf* pErrBuffer = getErrOstream().rdbuf( &errBuffer );
+   const bool ret = execute( rFilename, &files );
+   getErrOstream().rdbuf( pErrBuffer );
+   getErrOstream() << errBuffer.str();
+
+   if( !ret && !files.empty() )
+      m_pCppCache->store( key, files, rOutput.data() + begin,
+                          rOutput.size() - begin, errBuffer.str() );
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool CppExecution::getDependencies( const std::string& rFilename,
+                                    FILE_LIST_T& rFiles )
+{
+   std::string output;
+   const std::size_t size = addFileFlags( rFilename );
+   if( m_internal )
+   {
+      InternalCpp internalCpp( m_oOptionList, output, getErrOstream() );
+      m_oOptionList.resize( size );
+      internalCpp.setFileList( &rFiles );
+      return internalCpp( rFilename );
+   }
+
+   CppExecution dependencies( *this, output, getErrOstream() );
+   m_oOptionList.resize( size );
+   dependencies.m_oOptionList.push_back( "-M" );
+   dependencies.m_oOptionList.push_back( "-MG" );
+   if( dependencies.run( rFilename ) )
+      return true;
+
+   parseMakeRule( output, rFiles );
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+ * The rule is continued by backslash-newline.
+ */
+void CppExecution::parseMakeRule( const std::string& rRule, FILE_LIST_T& rFiles )
+{
+   std::size_t pos = rRule.find( ": " );
+   if( pos == std::string::npos )
+      return;
+   std::string name;
+   for( pos += 2; pos < rRule.size(); pos++ )
+   {
+      const char c = rRule[pos];
+      if( c == '\\' && (pos + 1 < rRule.size()) )
+      {
+         pos++;
+         if( rRule[pos] != '\n' )
+            name += rRule[pos];
+         continue;
+      }
+      if( !::isspace( c ) )
+      {
+         name += c;
+         continue;
+      }
+      if( !name.empty() )
+         rFiles.push_back( name );
+      name.clear();
+   }
+   if( !name.empty() )
+      rFiles.push_back( name );
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /*!----------------------------------------------------------------------------
 */
@@ -122,24 +300,68 @@ int CppCaller::CppOptionCallPath::onGiven( CLOP::PARSER* poParser )
    return 0;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+CppCaller::CppOptionMode::CppOptionMode( CppCaller* pCppCaller )
+   :CppOption( pCppCaller )
+{
+   m_shortOpt  = '\0';
+   m_longOpt   = "cpp";
+   m_helpText  = "Selects the preprocessor, PARAM is \"external\" or \"internal\".\n"
+                 "external: Invokes \"cpp\" respectively the by option \"-p\" given"
+                 " preprocessor for each source-file. (default)\n"
+                 "internal: Uses the built-in preprocessor, which doesn't need to"
+                 " start a process for each source-file.\n"
+                 "It handles \"#include\" for the directories given by \"-I\","
+                 " macro definitions and conditionals,\n"
+                 "but system-headers which are not found in the \"-I\" directories"
+                 " will skipped.\n"
+                 "E.g.: --cpp=internal";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int CppCaller::CppOptionMode::onGiven( CLOP::PARSER* poParser )
+{
+   if( poParser->getOptArg() == "internal" )
+   {
+      m_pParent->m_internal = true;
+      return 0;
+   }
+   if( poParser->getOptArg() == "external" )
+   {
+      m_pParent->m_internal = false;
+      return 0;
+   }
+   ERROR_MESSAGE( "Unknown preprocessor mode: \"" << poParser->getOptArg()
+                  << "\", expecting \"external\" or \"internal\"!" );
+   return -1;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 /*!----------------------------------------------------------------------------
 */
-CppCaller::CppCaller( std::ostream& rOstream, CommandlineParser& rParser )
-   :Execution( rOstream, std::cerr )
+CppCaller::CppCaller( std::string& rOutput, CommandlineParser& rParser )
+   :CppExecution( rOutput, std::cerr )
    ,m_oOptionInclude( this )
    ,m_oOptionDefine( this )
    ,m_oOptionUndefine( this )
    ,m_oCppOptionStd( this )
    ,m_oOptionCallPath( this )
+   ,m_oOptionMode( this )
+   ,m_oCompilationDb( rParser )
+   ,m_oCppCache( rParser )
 {
    rParser( m_oOptionInclude )( m_oOptionDefine )( m_oOptionUndefine )
-          ( m_oCppOptionStd )( m_oOptionCallPath );
+          ( m_oCppOptionStd )( m_oOptionCallPath )( m_oOptionMode );
    m_exe = "/usr/bin/cpp";
    m_oOptionList.push_back( "-P" );
    m_oOptionList.push_back( "-fdirectives-only" );
    m_oOptionList.push_back( "-D__DOCFSM__" );
+   m_pCompilationDb = &m_oCompilationDb;
+   m_pCppCache = &m_oCppCache;
 }
 
 //================================== EOF ======================================
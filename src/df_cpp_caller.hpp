@@ -15,13 +15,111 @@
 #ifndef __DOCFSM__
  #include "os_execute.hpp"
  #include "df_commandline.hpp"
+ #include "df_compdb.hpp"
+ #include "df_cpp_cache.hpp"
 #endif
 
 namespace DocFsm
 {
 
 ///////////////////////////////////////////////////////////////////////////////
-class CppCaller: public OS::Execution
+/*!
+ * @brief Common base of CppCaller and CppProcess, invokes either the
+ *        external preprocessor or the built-in one.
+ */
+class CppExecution: public OS::Execution
+{
+public:
+   using FILE_LIST_T = std::vector<std::string>;
+
+protected:
+   bool                         m_internal;
+   const CompilationDatabase*   m_pCompilationDb;
+   const CppCache*              m_pCppCache;
+
+   CppExecution( std::string& rStdBuffer, std::ostream& rErrOstream )
+      :Execution( rStdBuffer, rErrOstream )
+      ,m_internal( false )
+      ,m_pCompilationDb( nullptr )
+      ,m_pCppCache( nullptr )
+   {
+   }
+
+   CppExecution( const CppExecution& rOrigin,
+                 std::string& rStdBuffer, std::ostream& rErrOstream )
+      :Execution( rOrigin, rStdBuffer, rErrOstream )
+      ,m_internal( rOrigin.m_internal )
+      ,m_pCompilationDb( rOrigin.m_pCompilationDb )
+      ,m_pCppCache( rOrigin.m_pCppCache )
+   {
+   }
+
+   /*!
+    * @brief Appends the flags of the given source-file from the
+    *        compilation database to the option list.
+    * @return Size of the option list before, for restoring it by
+    *         m_oOptionList.resize().
+    */
+   std::size_t addFileFlags( const std::string& rFilename );
+
+private:
+   /*!
+    * @brief Invokes the preprocessor.
+    * @param pFiles If not nullptr it receives the names of all files read
+    *               by the preprocessor.
+    * @retval true Error
+    */
+   bool execute( const std::string& rFilename, FILE_LIST_T* pFiles );
+
+   /*!
+    * @brief Delivers the output from the CppCache or invokes the
+    *        preprocessor and stores its output in the CppCache.
+    * @retval true Error
+    */
+   bool executeCached( const std::string& rFilename, uint64_t key );
+
+   /*!
+    * @brief Appends the file names of a make-rule "target: files..."
+    *        as written by the preprocessor to rFiles.
+    */
+   static void parseMakeRule( const std::string& rRule, FILE_LIST_T& rFiles );
+
+public:
+   /*!
+    * @brief Appends the preprocessed source-code of the given file to the
+    *        standard output-buffer.
+    * @retval true Error
+    */
+   bool preprocess( const std::string& rFilename );
+
+   /*!
+    * @brief Appends the preprocessed source-code given in memory to the
+    *        standard output-buffer.
+    *
+    * The source-code is always preprocessed by the built-in preprocessor,
+    * because the external one can only read files. The options and the
+    * flags of the compilation database are the same as for a file.
+    * @param rFilename Name of the source, e.g. for resolving quoted includes.
+    * @param rSource   Source-code
+    * @retval true Error
+    */
+   bool preprocess( const std::string& rFilename, const std::string& rSource );
+
+   /*!
+    * @brief Appends the names of the given source-file and of all files
+    *        which it includes to rFiles, as reported by the preprocessor.
+    * @retval true Error
+    */
+   bool getDependencies( const std::string& rFilename, FILE_LIST_T& rFiles );
+
+   bool isInternal( void ) const
+   {
+      return m_internal;
+   }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+class CppCaller: public CppExecution
 {
    class CppOption: public CLOP::OPTION_V
    {
@@ -69,19 +167,46 @@ class CppCaller: public OS::Execution
       int onGiven( CLOP::PARSER* poParser ) override;
    };
 
+   class CppOptionMode: public CppOption
+   {
+   public:
+      CppOptionMode( CppCaller* pCppCaller );
+      int onGiven( CLOP::PARSER* poParser ) override;
+   };
+
    CppOptionInclude    m_oOptionInclude;
    CppOptionDefine     m_oOptionDefine;
    CppOptionUndefine   m_oOptionUndefine;
    CppOptionStd        m_oCppOptionStd;
    CppOptionCallPath   m_oOptionCallPath;
+   CppOptionMode       m_oOptionMode;
+   CompilationDatabase m_oCompilationDb;
+   CppCache            m_oCppCache;
 
 public:
-   CppCaller( std::ostream& rOstream, CommandlineParser& rParser );
+   CppCaller( std::string& rOutput, CommandlineParser& rParser );
    ~CppCaller( void )
    {
    }
 };
 
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Further preprocessor call with the same executable and options as
+ *        the given CppCaller object, but with own output buffers.
+ *
+ * Necessary for calling the preprocessor concurrently in worker threads.
+ */
+class CppProcess: public CppExecution
+{
+public:
+   CppProcess( const CppCaller& rOrigin,
+               std::string& rStdBuffer, std::ostream& rErrOstream )
+      :CppExecution( rOrigin, rStdBuffer, rErrOstream )
+   {
+   }
+};
+
 } // End namespace DocFsm
 
 #endif // ifndef _DF_CPP_CALLER_HPP
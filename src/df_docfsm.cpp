@@ -15,33 +15,65 @@
 #include "df_preparser.hpp"
 #include "df_dotgenerator.hpp"
 #include "df_transition_finder.hpp"
-#include "df_cpp_caller.hpp"
+#include "df_preprocess_pool.hpp"
+#include "df_model_cache.hpp"
+#include "df_statistics.hpp"
 #include "df_dot_keywords.hpp"
+#include "df_dot_writer.hpp"
+#include "df_server.hpp"
+#include "df_watcher.hpp"
 #include "df_docfsm.hpp"
 
 using namespace DocFsm;
 
-//=============================================================================
+/*!----------------------------------------------------------------------------
+ * @brief Prepares the collected model for the output and prints it.
+ * @retval true Error
+ */
+static bool print( StateCollector& rCollector, DotWriter& rDotWriter,
+                   Statistics& rStatistics )
+{
+   rStatistics.getClustering().start();
+   rCollector.splitInClusters();
+   rCollector.splitInGroups();
+   rCollector.generateTooltipFromLabel();
+   rStatistics.getClustering().stop();
 
-int main(int argc, char** ppArgv )
+   rStatistics.getPrint().start();
+   rCollector.print( rDotWriter );
+   const bool error = rDotWriter.close();
+   rStatistics.getPrint().stop();
+   return error;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Processes the command line, in the server mode each request too.
+ */
+static int docFsm( int argc, char** ppArgv )
 {
    std::string    out;
-   std::stringbuf str;
-   std::istream   inStream(&str);
-   std::ostream   outStream(&str);
 
    try
    {
       CommandlineParser  oCommandlineParser( argc, ppArgv );
       KeywordPool        oKeywordPool( oCommandlineParser );
-      CppCaller          cppCaller( outStream, oCommandlineParser );
+      PreprocessPool     preprocessPool( oCommandlineParser, oKeywordPool );
       SourceBrowser      sourceBrowser( out );
       StateCollector     collector( sourceBrowser, oKeywordPool, oCommandlineParser );
       TransitionFinder   transitionFinder( collector, oCommandlineParser );
       DotKeywords        dotKeyWords( oCommandlineParser );
+      ModelCache         modelCache( collector, transitionFinder,
+                                     oKeywordPool, oCommandlineParser );
+      Statistics         statistics( oCommandlineParser );
+      DotWriter          dotWriter( oCommandlineParser );
+      Server             server( oCommandlineParser );
+      Watcher            watcher( oCommandlineParser );
 
       if( oCommandlineParser() < 0 )
-         return EXIT_FAILURE;
+         return oCommandlineParser.isFinished()? EXIT_SUCCESS : EXIT_FAILURE;
+
+      if( server.isActive() )
+         return server( argc, ppArgv, docFsm );
 
       if( oCommandlineParser.getFileNameList().empty() )
       {
@@ -52,28 +84,97 @@ int main(int argc, char** ppArgv )
       if( oKeywordPool.setDefaultsIfEmpty() )
           return EXIT_FAILURE;
 
-      for( auto& fileName : oCommandlineParser.getFileNameList() )
+      if( watcher.isActive() )
+         return watcher( argc, ppArgv, oCommandlineParser.getFileNameList(),
+                         preprocessPool.getCppCaller(), docFsm );
+
+      if( dotWriter.isBatch() )
       {
-         if( cppCaller.run( fileName ) )
+         if( !dotWriter.getFileName().empty() )
+         {
+            ERROR_MESSAGE( "Options \"-o\" and \"--outdir\" can't be used together!" );
             return EXIT_FAILURE;
-
-         Preparser preparser( inStream, out );
-         if( preparser() )
+         }
+         if( DotWriter::checkFileNames( dotWriter.getDirectory(),
+                                        oCommandlineParser.getFileNameList() ) )
             return EXIT_FAILURE;
+      }
+      else if( dotWriter.open() )
+         return EXIT_FAILURE;
 
-         if( collector( fileName ) )
-            return EXIT_FAILURE;
+      statistics.start();
 
-         if( collector.isEmpty() )
-            continue;
+      if( preprocessPool.start( oCommandlineParser.getFileNameList() ) )
+         return EXIT_FAILURE;
+
+      std::size_t fileIndex = 0;
+      for( auto& fileName : oCommandlineParser.getFileNameList() )
+      {
+         Statistics::FILE_T& rStat = statistics.beginFile( fileName, collector );
 
-         if( transitionFinder() )
+         if( preprocessPool.get( fileIndex++, out, rStat.m_preprocess ) )
             return EXIT_FAILURE;
+
+         /*
+          * Each file begins with the same context, with and without
+          * the prefilter of the preprocess pool.
+          */
+         transitionFinder.resetContext();
+
+         if( rStat.m_preprocess.m_prefiltered )
+         { /*
+            * Without any keyword the file can't contain a state.
+            */
+            collector.warnNoKeywords( fileName );
+         }
+         else
+         {
+            rStat.m_cache.start();
+            rStat.m_cached = modelCache.load( fileName, out );
+            rStat.m_cache.stop();
+         }
+
+         if( !rStat.m_cached && !rStat.m_preprocess.m_prefiltered )
+         {
+            rStat.m_collect.start();
+            if( collector( fileName ) )
+               return EXIT_FAILURE;
+            rStat.m_collect.stop();
+
+            rStat.m_transitions.start();
+            if( !collector.isEmpty() && transitionFinder() )
+               return EXIT_FAILURE;
+            rStat.m_transitions.stop();
+
+            rStat.m_cache.start();
+            modelCache.store();
+            rStat.m_cache.stop();
+         }
+         statistics.endFile( collector );
+
+         /*
+          * In the batch mode each file gets its own graph and its model
+          * becomes released immediately, so the memory is bounded by the
+          * largest file.
+          */
+         if( !dotWriter.isBatch() )
+            continue;
+         if( !collector.isEmpty() )
+         {
+            if( dotWriter.open( DotWriter::makeFileName( dotWriter.getDirectory(),
+                                                         fileName ) ) )
+               return EXIT_FAILURE;
+            if( print( collector, dotWriter, statistics ) )
+               return EXIT_FAILURE;
+         }
+         collector.clear();
       }
-      collector.splitInClusters();
-      collector.splitInGroups();
-      collector.generateTooltipFromLabel();
-      collector.print( std::cout );
+
+      if( !dotWriter.isBatch() && print( collector, dotWriter, statistics ) )
+         return EXIT_FAILURE;
+
+      if( statistics.write() )
+         return EXIT_FAILURE;
    }
    catch( ... )
    {
@@ -83,4 +184,11 @@ int main(int argc, char** ppArgv )
    return EXIT_SUCCESS;
 }
 
+//=============================================================================
+
+int main(int argc, char** ppArgv )
+{
+   return docFsm( argc, ppArgv );
+}
+
 //================================== EOF ======================================
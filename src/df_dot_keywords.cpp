@@ -16,161 +16,212 @@ using namespace DocFsm;
 
 /*!----------------------------------------------------------------------------
 */
-const DotKeywords::DOT_ATTR_LIST_T DotKeywords::c_edgeAttributes =
+const DotKeywords::DOT_ATTR_ITEM_T DotKeywords::c_edgeItems[] =
 {
-   std::make_tuple("arrowhead",   "style of arrowhead at head end", NOTHING, DOT ),
-   std::make_tuple("arrowsize",   "scaling factor for arrowheads", NOTHING, DOT ),
-   std::make_tuple("arrowtail",   "style of arrowhead at tail end", NOTHING, DOT ),
-   std::make_tuple("color",       "edge stroke color",COLOR, DOT ),
-   std::make_tuple("colorscheme", "scheme for interpreting color names", NOTHING, DOT ),
-   std::make_tuple("comment",     "any string (format-dependent)", NOTHING, DOT ),
-   std::make_tuple("constraint",  "use edge to affect node ranking", NOTHING, DOT ),
-   std::make_tuple("decorate",    "if set, draws a line connecting labels with their edges",NOTHING, DOT ),
-   std::make_tuple("dir",         "forward, back, both, or none", NOTHING, DOT ),
-   std::make_tuple("edgeURL",     "URL attached to non-label part of edge", NOTHING, DOT ),
-   std::make_tuple("edgehref",    "synonym for edgeURL", NOTHING, DOT ),
-   std::make_tuple("edgetarget",  "if URL is set, determines browser window for URL", NOTHING, DOT ),
-   std::make_tuple("edgetooltip", "tooltip annotation for non-label part of edge", NOTHING, DOT ),
-   std::make_tuple("fontcolor",   "type face color", FONTCOLOR, DOT ),  
-   std::make_tuple("fontname",    "font family", NOTHING, DOT ),
-   std::make_tuple("fontsize",    "point size of label", NOTHING, DOT ),
-   std::make_tuple("headclip",    "if false, edge is not clipped to head node boundary", NOTHING, DOT ),
-   std::make_tuple("headhref",    "synonym for headURL", NOTHING, DOT ),
-   std::make_tuple("headlabel",   "label placed near head of edge", NOTHING, DOT ),
-   std::make_tuple("headport",    "n,ne,e,se,s,sw,w,nw",NOTHING, DOT),
-   std::make_tuple("headtarget",  "if headURL is set, determines browser window for URL", NOTHING, DOT ),
-   std::make_tuple("headtooltip", "tooltip annotation near head of edge", NOTHING, DOT ),
-   std::make_tuple("headURL",     "URL attached to head label", URL, DOT ),
-   std::make_tuple("href",        "alias for URL", URL, DOT ),
-   std::make_tuple("id",          "any string (user-defined output object tags)" ,NOTHING, DOT ),
-   std::make_tuple("label",       "edge label", LABEL, DOT ),
-   std::make_tuple("labelangle",  "angle in degrees which head or tail label is rotated off edge", NOTHING, DOT ),
-   std::make_tuple("labeldistance","scaling factor for distance of head or tail label from node", NOTHING, DOT ),
-   std::make_tuple("labelfloat",  "lessen constraints on edge label placement", NOTHING, DOT ),
-   std::make_tuple("labelfontcolor","type face color for head and tail labels", NOTHING, DOT ),
-   std::make_tuple("labelfontname","font family for head and tail labels", NOTHING, DOT ),
-   std::make_tuple("labelfontsize","point size for head and tail labels", NOTHING, DOT ),
-   std::make_tuple("labelhref",   "synonym for labelURL", NOTHING, DOT ),
-   std::make_tuple("labelURL",    "URL for label, overrides edge URL", NOTHING, DOT ),
-   std::make_tuple("labeltarget", "if URL or labelURL is set, determines browser window for URL", NOTHING, DOT ),
-   std::make_tuple("labeltooltip","ooltip annotation near label", NOTHING, DOT ),
-   std::make_tuple("layer",       "all, id or id:id, or a comma-separated list of the former", NOTHING, DOT ),
-   std::make_tuple("lhead",       "name of cluster to use as head of edge", NOTHING, DOT ),
-   std::make_tuple("ltail",       "name of cluster to use as tail of edge", NOTHING, DOT ),
-   std::make_tuple("minlen",      "minimum rank distance between head and tail", NOTHING, DOT ),
-   std::make_tuple("penwidth",    "width of pen for drawing edge stroke, in points", NOTHING, DOT ),
-   std::make_tuple("samehead",    "tag for head node; edge heads with the same tag are merged onto the same port" ,NOTHING, DOT ),
-   std::make_tuple("sametail",    "tag for tail node; edge tails with the same tag are merged onto the same port", NOTHING, DOT ),
-   std::make_tuple("style",       "graphics options, e.g. bold, dotted, filled;", STYLE, DOT ),
-   std::make_tuple("tailclip",    "if false, edge is not clipped to tail node boundary", NOTHING, DOT ),
-   std::make_tuple("tailhref",    "synonym for tailURL", NOTHING, DOT ),
-   std::make_tuple("taillabel",   "label placed near tail of edge", NOTHING, DOT ),
-   std::make_tuple("tailport",    "n,ne,e,se,s,sw,w,nw", NOTHING, DOT ),
-   std::make_tuple("tailtarget",  "if tailURL is set, determines browser window for URL", NOTHING, DOT ),
-   std::make_tuple("tailtooltip", "tooltip annotation near tail of edge", NOTHING, DOT ),
-   std::make_tuple("tailURL",     "URL attached to tail label", URL, DOT ),
-   std::make_tuple("target",      "if URL is set, determines browser window for URL", NOTHING, DOT ),
-   std::make_tuple("tooltip",     "tooltip annotation", TOOLTIP, DOT ),
-   std::make_tuple("weight",      "integer cost of stretching an edge", NOTHING, DOT )
+   { "arrowhead",   "style of arrowhead at head end", NOTHING, DOT  },
+   { "arrowsize",   "scaling factor for arrowheads", NOTHING, DOT  },
+   { "arrowtail",   "style of arrowhead at tail end", NOTHING, DOT  },
+   { "color",       "edge stroke color",COLOR, DOT  },
+   { "colorscheme", "scheme for interpreting color names", NOTHING, DOT  },
+   { "comment",     "any string (format-dependent)", NOTHING, DOT  },
+   { "constraint",  "use edge to affect node ranking", NOTHING, DOT  },
+   { "decorate",    "if set, draws a line connecting labels with their edges",NOTHING, DOT  },
+   { "dir",         "forward, back, both, or none", NOTHING, DOT  },
+   { "edgeURL",     "URL attached to non-label part of edge", NOTHING, DOT  },
+   { "edgehref",    "synonym for edgeURL", NOTHING, DOT  },
+   { "edgetarget",  "if URL is set, determines browser window for URL", NOTHING, DOT  },
+   { "edgetooltip", "tooltip annotation for non-label part of edge", NOTHING, DOT  },
+   { "fontcolor",   "type face color", FONTCOLOR, DOT  },
+   { "fontname",    "font family", NOTHING, DOT  },
+   { "fontsize",    "point size of label", NOTHING, DOT  },
+   { "headclip",    "if false, edge is not clipped to head node boundary", NOTHING, DOT  },
+   { "headhref",    "synonym for headURL", NOTHING, DOT  },
+   { "headlabel",   "label placed near head of edge", NOTHING, DOT  },
+   { "headport",    "n,ne,e,se,s,sw,w,nw",NOTHING, DOT },
+   { "headtarget",  "if headURL is set, determines browser window for URL", NOTHING, DOT  },
+   { "headtooltip", "tooltip annotation near head of edge", NOTHING, DOT  },
+   { "headURL",     "URL attached to head label", URL, DOT  },
+   { "href",        "alias for URL", URL, DOT  },
+   { "id",          "any string (user-defined output object tags)" ,NOTHING, DOT  },
+   { "label",       "edge label", LABEL, DOT  },
+   { "labelangle",  "angle in degrees which head or tail label is rotated off edge", NOTHING, DOT  },
+   { "labeldistance","scaling factor for distance of head or tail label from node", NOTHING, DOT  },
+   { "labelfloat",  "lessen constraints on edge label placement", NOTHING, DOT  },
+   { "labelfontcolor","type face color for head and tail labels", NOTHING, DOT  },
+   { "labelfontname","font family for head and tail labels", NOTHING, DOT  },
+   { "labelfontsize","point size for head and tail labels", NOTHING, DOT  },
+   { "labelhref",   "synonym for labelURL", NOTHING, DOT  },
+   { "labelURL",    "URL for label, overrides edge URL", NOTHING, DOT  },
+   { "labeltarget", "if URL or labelURL is set, determines browser window for URL", NOTHING, DOT  },
+   { "labeltooltip","ooltip annotation near label", NOTHING, DOT  },
+   { "layer",       "all, id or id:id, or a comma-separated list of the former", NOTHING, DOT  },
+   { "lhead",       "name of cluster to use as head of edge", NOTHING, DOT  },
+   { "ltail",       "name of cluster to use as tail of edge", NOTHING, DOT  },
+   { "minlen",      "minimum rank distance between head and tail", NOTHING, DOT  },
+   { "penwidth",    "width of pen for drawing edge stroke, in points", NOTHING, DOT  },
+   { "samehead",    "tag for head node; edge heads with the same tag are merged onto the same port" ,NOTHING, DOT  },
+   { "sametail",    "tag for tail node; edge tails with the same tag are merged onto the same port", NOTHING, DOT  },
+   { "style",       "graphics options, e.g. bold, dotted, filled;", STYLE, DOT  },
+   { "tailclip",    "if false, edge is not clipped to tail node boundary", NOTHING, DOT  },
+   { "tailhref",    "synonym for tailURL", NOTHING, DOT  },
+   { "taillabel",   "label placed near tail of edge", NOTHING, DOT  },
+   { "tailport",    "n,ne,e,se,s,sw,w,nw", NOTHING, DOT  },
+   { "tailtarget",  "if tailURL is set, determines browser window for URL", NOTHING, DOT  },
+   { "tailtooltip", "tooltip annotation near tail of edge", NOTHING, DOT  },
+   { "tailURL",     "URL attached to tail label", URL, DOT  },
+   { "target",      "if URL is set, determines browser window for URL", NOTHING, DOT  },
+   { "tooltip",     "tooltip annotation", TOOLTIP, DOT  },
+   { "weight",      "integer cost of stretching an edge", NOTHING, DOT  }
 };
 
 /*!----------------------------------------------------------------------------
 */
-const DotKeywords::DOT_ATTR_LIST_T DotKeywords::c_nodeAttributes =
+const DotKeywords::DOT_ATTR_ITEM_T DotKeywords::c_nodeItems[] =
 {
-   std::make_tuple("color",       "node shape color", COLOR, DOT),
-   std::make_tuple("colorscheme", "scheme for interpreting color names", NOTHING, DOT),
-   std::make_tuple("comment",     "any string (format-dependent)", NOTHING, DOT),
-   std::make_tuple("distortion",  "node distortion for shape=polygon", NOTHING, DOT),
-   std::make_tuple("fillcolor",   "node fill color", FILLCOLOR, DOT),
-   std::make_tuple("fixedsize",   "label text has no affect on node size", NOTHING, DOT),
-   std::make_tuple("fontcolor",   "type face color", FONTCOLOR, DOT),
-   std::make_tuple("fontname",    "font family", NOTHING, DOT),
-   std::make_tuple("fontsize",    "point size of label", NOTHING, DOT), 
-   std::make_tuple("group",       "name of node’s horizontal alignment group", NOTHING, DOT),
-   std::make_tuple("height",      "minimum height in inches", NOTHING, DOT),
-   std::make_tuple("id",          "any string (user-defined output object tags)", NOTHING, DOT),
-   std::make_tuple("image",       "image file name", NOTHING, DOT),
-   std::make_tuple("imagescale",  "true, width, height, both", NOTHING, DOT),
-   std::make_tuple("label",       "any string", LABEL, DOT),
-   std::make_tuple("labelloc",    "node label vertical alignment", NOTHING, DOT),
-   std::make_tuple("layer",       "all, id or id:id, or a comma-separated list of the former", NOTHING, DOT),
-   std::make_tuple("margin",      "space around labe", NOTHING, DOT),
-   std::make_tuple("nojustify",   "if true, justify to label, not node", NOTHING, DOT),
-   std::make_tuple("orientation", "node rotation angle", NOTHING, DOT),
-   std::make_tuple("penwidth",    "width of pen for drawing boundaries, in points", NOTHING, DOT),
-   std::make_tuple("peripheries", "number of node boundaries", NOTHING, DOT),
-   std::make_tuple("regular",     "force polygon to be regular", NOTHING, DOT),
-   std::make_tuple("samplepoints","number vertices to convert circle or ellipse", NOTHING, DOT),
-   std::make_tuple("shape",       "node shape", SHAPE, DOT),
-   std::make_tuple("sides",       "number of sides for shape=polygon", NOTHING, DOT),
-   std::make_tuple("skew",        "skewing of node for shape=polygon", NOTHING, DOT),
-   std::make_tuple("style",       "graphics options, e.g. bold, dotted, filled;", STYLE, DOT),
-   std::make_tuple("target",      "if URL is set, determines browser window for URL", NOTHING, DOT),
-   std::make_tuple("tooltip",     "tooltip annotation", TOOLTIP, DOT),
-   std::make_tuple("URL",         "URL associated with node (format-dependent)", URL, DOT),
-   std::make_tuple("width",       "minimum width in inches", NOTHING, DOT),
+   { "color",       "node shape color", COLOR, DOT },
+   { "colorscheme", "scheme for interpreting color names", NOTHING, DOT },
+   { "comment",     "any string (format-dependent)", NOTHING, DOT },
+   { "distortion",  "node distortion for shape=polygon", NOTHING, DOT },
+   { "fillcolor",   "node fill color", FILLCOLOR, DOT },
+   { "fixedsize",   "label text has no affect on node size", NOTHING, DOT },
+   { "fontcolor",   "type face color", FONTCOLOR, DOT },
+   { "fontname",    "font family", NOTHING, DOT },
+   { "fontsize",    "point size of label", NOTHING, DOT },
+   { "group",       "name of node’s horizontal alignment group", NOTHING, DOT },
+   { "height",      "minimum height in inches", NOTHING, DOT },
+   { "id",          "any string (user-defined output object tags)", NOTHING, DOT },
+   { "image",       "image file name", NOTHING, DOT },
+   { "imagescale",  "true, width, height, both", NOTHING, DOT },
+   { "label",       "any string", LABEL, DOT },
+   { "labelloc",    "node label vertical alignment", NOTHING, DOT },
+   { "layer",       "all, id or id:id, or a comma-separated list of the former", NOTHING, DOT },
+   { "margin",      "space around labe", NOTHING, DOT },
+   { "nojustify",   "if true, justify to label, not node", NOTHING, DOT },
+   { "orientation", "node rotation angle", NOTHING, DOT },
+   { "penwidth",    "width of pen for drawing boundaries, in points", NOTHING, DOT },
+   { "peripheries", "number of node boundaries", NOTHING, DOT },
+   { "regular",     "force polygon to be regular", NOTHING, DOT },
+   { "samplepoints","number vertices to convert circle or ellipse", NOTHING, DOT },
+   { "shape",       "node shape", SHAPE, DOT },
+   { "sides",       "number of sides for shape=polygon", NOTHING, DOT },
+   { "skew",        "skewing of node for shape=polygon", NOTHING, DOT },
+   { "style",       "graphics options, e.g. bold, dotted, filled;", STYLE, DOT },
+   { "target",      "if URL is set, determines browser window for URL", NOTHING, DOT },
+   { "tooltip",     "tooltip annotation", TOOLTIP, DOT },
+   { "URL",         "URL associated with node (format-dependent)", URL, DOT },
+   { "width",       "minimum width in inches", NOTHING, DOT },
 
-   std::make_tuple("GROUP",       "name of belonging group for this state, if grouping desired", GROUP, DOCFSM )
+   { "GROUP",       "name of belonging group for this state, if grouping desired", GROUP, DOCFSM  }
 };
 
 /*!----------------------------------------------------------------------------
 */
-const DotKeywords::DOT_ATTR_LIST_T DotKeywords::c_graphAttributes =
+const DotKeywords::DOT_ATTR_ITEM_T DotKeywords::c_graphItems[] =
 {
-   std::make_tuple("aspect",      "controls aspect ratio adjustment", NOTHING, DOT ),
-   std::make_tuple("bgcolor",     "background color for drawing, plus initial fill color", NOTHING, DOT ),
-   std::make_tuple("center",      "center drawing on page", NOTHING, DOT ),
-   std::make_tuple("clusterrank", "may be global or none", NOTHING, DOT ),
-   std::make_tuple("color",       "for clusters, outline color, and fill color if fillcolor not defined", COLOR, DOT ),
-   std::make_tuple("colorscheme", "scheme for interpreting color names", NOTHING, DOT ),
-   std::make_tuple("comment",     "any string (format-dependent)", NOTHING, DOT ),
-   std::make_tuple("compound",    "allow edges between clusters", NOTHING, DOT ),
-   std::make_tuple("concentrate", "enables edge concentrators", NOTHING, DOT ),
-   std::make_tuple("dpi",         "dots per inch for image output", NOTHING, DOT ),
-   std::make_tuple("fillcolor",   "cluster fill color", FILLCOLOR, DOT ),
-   std::make_tuple("fontcolor",   "type face color", FONTCOLOR, DOT ),
-   std::make_tuple("fontname",    "font family", NOTHING, DOT ),
-   std::make_tuple("fontnames",   "svg, ps, gd (SVG only)", NOTHING, DOT ),
-   std::make_tuple("fontpath",    "list of directories to search for fonts", NOTHING, DOT ),
-   std::make_tuple("fontsize",    "point size of label", NOTHING, DOT ),
-   std::make_tuple("id",          "any string (user-defined output object tags)", NOTHING, DOT ),
-   std::make_tuple("label",       "any string", LABEL, DOT ),
-   std::make_tuple("labeljust",   "\"l\" and \"r\" for left- and right-justified cluster labels, respectively", NOTHING, DOT ),
-   std::make_tuple("labelloc",    "\"t\" and \"b\" for top- and bottom-justified cluster labels, respectively", NOTHING, DOT ),
-   std::make_tuple("landscape",   "if true, means orientation=landscape", NOTHING, DOT ),
-   std::make_tuple("layers",      "id:id:id...", NOTHING, DOT ),
-   std::make_tuple("layersep",    "specifies separator character to split layers", NOTHING, DOT ),
-   std::make_tuple("margin",      "margin included in page, inches", NOTHING, DOT ),
-   std::make_tuple("mindist",     "minimum separation between all nodes (not dot)", NOTHING, DOT ),
-   std::make_tuple("nodesep",     "separation between nodes, in inches.", NOTHING, DOT ),
-   std::make_tuple("nojustify",   "if true, justify to label, not graph", NOTHING, DOT ),
-   std::make_tuple("ordering",    "if out, out edge order is preserved", NOTHING, DOT ),
-   std::make_tuple("orientation", "if rotate is not used and the value is landscape, use landscape orientation", NOTHING, DOT ),
-   std::make_tuple("outputorder", "breadthfirst or nodesfirst, edgesfirst", NOTHING, DOT ),
-   std::make_tuple("page",        "unit of pagination, e.g. \"8.5,11\"", NOTHING, DOT ),
-   std::make_tuple("pagedir",     "traversal order of pages", NOTHING, DOT ),
-   std::make_tuple("pencolor",    "color for drawing cluster boundaries" ,NOTHING, DOT ),
-   std::make_tuple("penwidth",    "width of pen for drawing boundaries, in points", NOTHING, DOT ),
-   std::make_tuple("peripheries", "number of cluster boundaries", NOTHING, DOT),
-   std::make_tuple("rank",        "same, min, max, source or sink", NOTHING, DOT),
-   std::make_tuple("rankdir",     "LR (left to right) or TB (top to bottom)", NOTHING, DOT ),
-   std::make_tuple("ranksep",     "separation between ranks, in inches.", NOTHING, DOT),
-   std::make_tuple("ratio",       "approximate aspect ratio desired, fill or auto minimization", NOTHING, DOT),
-   std::make_tuple("rotate",      "If 90, set orientation to landscape", NOTHING, DOT),
-   std::make_tuple("samplepoints","number of points used to represent ellipses and circles on output", NOTHING, DOT),
-   std::make_tuple("searchsize",  "maximum edges with negative cut values to check when looking for a minimum one during network simplex", NOTHING, DOT),
-   std::make_tuple("size",        "maximum drawing size, in inches", NOTHING, DOT),
-   std::make_tuple("splines",     "draw edges as splines, polylines, lines", NOTHING, DOT ),
-   std::make_tuple("style",       "graphics options, e.g. filled for clusters", STYLE, DOT ),
-   std::make_tuple("stylesheet",  "pathname or URL to XML style sheet for SVG", NOTHING, DOT ),
-   std::make_tuple("target",      "if URL is set, determines browser window for URL", NOTHING, DOT ),
-   std::make_tuple("tooltip",     "tooltip annotation for cluster", TOOLTIP, DOT ),
-   std::make_tuple("truecolor",   "if set, force 24 bit or indexed color in image output", NOTHING, DOT ),
-   std::make_tuple("viewport",    "clipping window on output", NOTHING, DOT ),
-   std::make_tuple("URL",         "URL associated with graph (format-dependent)", URL, DOT )
+   { "aspect",      "controls aspect ratio adjustment", NOTHING, DOT  },
+   { "bgcolor",     "background color for drawing, plus initial fill color", NOTHING, DOT  },
+   { "center",      "center drawing on page", NOTHING, DOT  },
+   { "clusterrank", "may be global or none", NOTHING, DOT  },
+   { "color",       "for clusters, outline color, and fill color if fillcolor not defined", COLOR, DOT  },
+   { "colorscheme", "scheme for interpreting color names", NOTHING, DOT  },
+   { "comment",     "any string (format-dependent)", NOTHING, DOT  },
+   { "compound",    "allow edges between clusters", NOTHING, DOT  },
+   { "concentrate", "enables edge concentrators", NOTHING, DOT  },
+   { "dpi",         "dots per inch for image output", NOTHING, DOT  },
+   { "fillcolor",   "cluster fill color", FILLCOLOR, DOT  },
+   { "fontcolor",   "type face color", FONTCOLOR, DOT  },
+   { "fontname",    "font family", NOTHING, DOT  },
+   { "fontnames",   "svg, ps, gd (SVG only)", NOTHING, DOT  },
+   { "fontpath",    "list of directories to search for fonts", NOTHING, DOT  },
+   { "fontsize",    "point size of label", NOTHING, DOT  },
+   { "id",          "any string (user-defined output object tags)", NOTHING, DOT  },
+   { "label",       "any string", LABEL, DOT  },
+   { "labeljust",   "\"l\" and \"r\" for left- and right-justified cluster labels, respectively", NOTHING, DOT  },
+   { "labelloc",    "\"t\" and \"b\" for top- and bottom-justified cluster labels, respectively", NOTHING, DOT  },
+   { "landscape",   "if true, means orientation=landscape", NOTHING, DOT  },
+   { "layers",      "id:id:id...", NOTHING, DOT  },
+   { "layersep",    "specifies separator character to split layers", NOTHING, DOT  },
+   { "margin",      "margin included in page, inches", NOTHING, DOT  },
+   { "mindist",     "minimum separation between all nodes (not dot)", NOTHING, DOT  },
+   { "nodesep",     "separation between nodes, in inches.", NOTHING, DOT  },
+   { "nojustify",   "if true, justify to label, not graph", NOTHING, DOT  },
+   { "ordering",    "if out, out edge order is preserved", NOTHING, DOT  },
+   { "orientation", "if rotate is not used and the value is landscape, use landscape orientation", NOTHING, DOT  },
+   { "outputorder", "breadthfirst or nodesfirst, edgesfirst", NOTHING, DOT  },
+   { "page",        "unit of pagination, e.g. \"8.5,11\"", NOTHING, DOT  },
+   { "pagedir",     "traversal order of pages", NOTHING, DOT  },
+   { "pencolor",    "color for drawing cluster boundaries" ,NOTHING, DOT  },
+   { "penwidth",    "width of pen for drawing boundaries, in points", NOTHING, DOT  },
+   { "peripheries", "number of cluster boundaries", NOTHING, DOT },
+   { "rank",        "same, min, max, source or sink", NOTHING, DOT },
+   { "rankdir",     "LR (left to right) or TB (top to bottom)", NOTHING, DOT  },
+   { "ranksep",     "separation between ranks, in inches.", NOTHING, DOT },
+   { "ratio",       "approximate aspect ratio desired, fill or auto minimization", NOTHING, DOT },
+   { "rotate",      "If 90, set orientation to landscape", NOTHING, DOT },
+   { "samplepoints","number of points used to represent ellipses and circles on output", NOTHING, DOT },
+   { "searchsize",  "maximum edges with negative cut values to check when looking for a minimum one during network simplex", NOTHING, DOT },
+   { "size",        "maximum drawing size, in inches", NOTHING, DOT },
+   { "splines",     "draw edges as splines, polylines, lines", NOTHING, DOT  },
+   { "style",       "graphics options, e.g. filled for clusters", STYLE, DOT  },
+   { "stylesheet",  "pathname or URL to XML style sheet for SVG", NOTHING, DOT  },
+   { "target",      "if URL is set, determines browser window for URL", NOTHING, DOT  },
+   { "tooltip",     "tooltip annotation for cluster", TOOLTIP, DOT  },
+   { "truecolor",   "if set, force 24 bit or indexed color in image output", NOTHING, DOT  },
+   { "viewport",    "clipping window on output", NOTHING, DOT  },
+   { "URL",         "URL associated with graph (format-dependent)", URL, DOT  }
 };
 
+const DotKeywords::DOT_ATTR_LIST_T DotKeywords::c_edgeAttributes( c_edgeItems );
+const DotKeywords::DOT_ATTR_LIST_T DotKeywords::c_nodeAttributes( c_nodeItems );
+const DotKeywords::DOT_ATTR_LIST_T DotKeywords::c_graphAttributes( c_graphItems );
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+ * 32 bit FNV-1a hash.
+ */
+std::size_t DotKeywords::DOT_ATTR_LIST_T::hash( const char* pWord, std::size_t len )
+{
+   uint32_t h = 0x811C9DC5;
+   for( std::size_t i = 0; i < len; i++ )
+   {
+      h ^= static_cast<uint8_t>( pWord[i] );
+      h *= 0x01000193;
+   }
+   return h;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void DotKeywords::DOT_ATTR_LIST_T::buildIndex( void )
+{
+   ::memset( m_index, 0, sizeof( m_index ) );
+   for( std::size_t i = 0; i < m_size; i++ )
+   {
+      std::size_t slot = hash( m_pItems[i].m_keyWord,
+                               ::strlen( m_pItems[i].m_keyWord ) ) % c_indexSize;
+      while( m_index[slot] != 0 )
+         slot = (slot + 1) % c_indexSize;
+      m_index[slot] = i + 1;
+   }
+}
+
+/*!----------------------------------------------------------------------------
+*/
+const DotKeywords::DOT_ATTR_ITEM_T*
+DotKeywords::DOT_ATTR_LIST_T::find( const char* pWord, std::size_t len ) const
+{
+   std::size_t slot = hash( pWord, len ) % c_indexSize;
+   while( m_index[slot] != 0 )
+   {
+      const DOT_ATTR_ITEM_T& rItem = m_pItems[m_index[slot] - 1];
+      if( (::strncmp( rItem.m_keyWord, pWord, len ) == 0) &&
+          (rItem.m_keyWord[len] == '\0') )
+         return &rItem;
+      slot = (slot + 1) % c_indexSize;
+   }
+   return nullptr;
+}
+
 /*!----------------------------------------------------------------------------
 */
 DotKeywords::OptionListNodeWords::OptionListNodeWords( DotKeywords* pParent )
@@ -186,10 +237,10 @@ DotKeywords::OptionListNodeWords::OptionListNodeWords( DotKeywords* pParent )
 */
 int DotKeywords::OptionListNodeWords::onGiven( CLOP::PARSER* poParser )
 {
-   m_pParent->list( c_nodeAttributes, 
-                    static_cast<CommandlineParser*>(poParser)->isVerbose() );
-   ::exit( EXIT_SUCCESS );
-   return 0;
+   CommandlineParser* poCommandlineParser = static_cast<CommandlineParser*>(poParser);
+   m_pParent->list( poCommandlineParser->getOut(), c_nodeAttributes,
+                    poCommandlineParser->isVerbose() );
+   return poCommandlineParser->finish();
 }
 
 /*!----------------------------------------------------------------------------
@@ -207,10 +258,10 @@ DotKeywords::OptionListEdgeWords::OptionListEdgeWords( DotKeywords* pParent )
 */
 int DotKeywords::OptionListEdgeWords::onGiven( CLOP::PARSER* poParser )
 {
-   m_pParent->list( c_edgeAttributes, 
-                    static_cast<CommandlineParser*>(poParser)->isVerbose() );
-   ::exit( EXIT_SUCCESS );
-   return 0;
+   CommandlineParser* poCommandlineParser = static_cast<CommandlineParser*>(poParser);
+   m_pParent->list( poCommandlineParser->getOut(), c_edgeAttributes,
+                    poCommandlineParser->isVerbose() );
+   return poCommandlineParser->finish();
 }
 
 /*!----------------------------------------------------------------------------
@@ -228,10 +279,10 @@ DotKeywords::OptionListGraphWords::OptionListGraphWords( DotKeywords* pParent )
 */
 int DotKeywords::OptionListGraphWords::onGiven( CLOP::PARSER* poParser )
 {
-   m_pParent->list( c_graphAttributes, 
-                    static_cast<CommandlineParser*>(poParser)->isVerbose() );
-   ::exit( EXIT_SUCCESS );
-   return 0;
+   CommandlineParser* poCommandlineParser = static_cast<CommandlineParser*>(poParser);
+   m_pParent->list( poCommandlineParser->getOut(), c_graphAttributes,
+                    poCommandlineParser->isVerbose() );
+   return poCommandlineParser->finish();
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -249,33 +300,21 @@ DotKeywords::DotKeywords( CommandlineParser& rCommandlineParser )
 
 /*!----------------------------------------------------------------------------
 */
-const DotKeywords::DOT_ATTR_ITEM_T* DotKeywords::find( const DOT_ATTR_LIST_T& rList,
-                                                       const std::string& word )
-{
-   for( const auto& item : rList )
-   {
-      if( getKeyWord( item ) == word )
-         return &item;
-   }
-   return nullptr;
-}
-
-/*!----------------------------------------------------------------------------
-*/
-void DotKeywords::list( const DOT_ATTR_LIST_T& rList, bool verbose )
+void DotKeywords::list( std::ostream& rOut, const DOT_ATTR_LIST_T& rList,
+                        bool verbose )
 {
    for( const auto& item : rList )
    {
       if( verbose )
-          std::cout << BOLD;
-      std::cout << getKeyWord( item );
+          rOut << BOLD;
+      rOut << getKeyWord( item );
       if( verbose )
       {
-         for( int i = getKeyWord( item ).size(); i < 20; i++ )
-             std::cout << ' ';
-         std::cout << NORMAL << getHelpText( item );
+         for( int i = ::strlen( getKeyWord( item ) ); i < 20; i++ )
+             rOut << ' ';
+         rOut << NORMAL << getHelpText( item );
       }
-      std::cout << std::endl;
+      rOut << std::endl;
    }
 }
 
@@ -13,7 +13,8 @@
 #define _DF_DOT_KEYWORDS_HPP
 
 #ifndef __DOCFSM__
- #include <tuple>
+ #include <stdint.h>
+ #include <string.h>
  #include <sstream>
  #include <assert.h>
 #endif
@@ -83,8 +84,62 @@ public:
       DOCFSM //!< Attributes for DocFsm
    };
 
-   using DOT_ATTR_ITEM_T = std::tuple< std::string, std::string, ID_T, KATEGORY_T >;
-   using DOT_ATTR_LIST_T = std::vector<DOT_ATTR_ITEM_T>;
+   /*!
+    * @brief Item of a constant attribute table, contains no objects which
+    *        need a construction at program start.
+    */
+   struct DOT_ATTR_ITEM_T
+   {
+      const char*  m_keyWord;
+      const char*  m_helpText;
+      ID_T         m_id;
+      KATEGORY_T   m_kategory;
+   };
+
+   /*!
+    * @brief Constant table of attribute items with a hash index of their
+    *        keywords.
+    *
+    * The index is an open addressed hash table of item positions with at
+    * least twice as much slots as items, so a keyword is found respectively
+    * rejected by one probe in the most cases. It becomes built by the
+    * constructor without any allocation.
+    */
+   class DOT_ATTR_LIST_T
+   {
+      static constexpr std::size_t c_indexSize = 256;
+
+      const DOT_ATTR_ITEM_T* m_pItems;
+      std::size_t            m_size;
+      uint8_t                m_index[c_indexSize]; //!< Position + 1, 0: empty.
+
+   public:
+      template< std::size_t N >
+      DOT_ATTR_LIST_T( const DOT_ATTR_ITEM_T (&rItems)[N] )
+         :m_pItems( rItems )
+         ,m_size( N )
+      {
+         static_assert( 2 * N <= c_indexSize, "Index of DOT-attributes too small!" );
+         buildIndex();
+      }
+
+      const DOT_ATTR_ITEM_T* begin( void ) const { return m_pItems; }
+      const DOT_ATTR_ITEM_T* end( void ) const { return m_pItems + m_size; }
+      const DOT_ATTR_ITEM_T& front( void ) const { return m_pItems[0]; }
+      const DOT_ATTR_ITEM_T& back( void ) const { return m_pItems[m_size-1]; }
+      std::size_t size( void ) const { return m_size; }
+      const DOT_ATTR_ITEM_T& operator[]( std::size_t i ) const
+      {
+         assert( i < m_size );
+         return m_pItems[i];
+      }
+
+      const DOT_ATTR_ITEM_T* find( const char* pWord, std::size_t len ) const;
+
+   private:
+      void buildIndex( void );
+      static std::size_t hash( const char* pWord, std::size_t len );
+   };
 
    const static DOT_ATTR_LIST_T c_edgeAttributes;
    const static DOT_ATTR_LIST_T c_nodeAttributes;
@@ -92,27 +147,31 @@ public:
 
    DotKeywords( CommandlineParser& );
 
-   static const std::string& getKeyWord( const DOT_ATTR_ITEM_T& rItem )
+   static const char* getKeyWord( const DOT_ATTR_ITEM_T& rItem )
    {
-      return std::get<0>( rItem );
+      return rItem.m_keyWord;
    }
 
-   static const std::string& getHelpText( const DOT_ATTR_ITEM_T& rItem )
+   static const char* getHelpText( const DOT_ATTR_ITEM_T& rItem )
    {
-      return std::get<1>( rItem );
+      return rItem.m_helpText;
    }
 
    static const ID_T getId( const DOT_ATTR_ITEM_T& rItem )
    {
-      return std::get<2>( rItem );
+      return rItem.m_id;
    }
 
    static const KATEGORY_T getKategory( const DOT_ATTR_ITEM_T& rItem )
    {
-      return std::get<3>( rItem );
+      return rItem.m_kategory;
    }
 
-   static const DOT_ATTR_ITEM_T* find( const DOT_ATTR_LIST_T&, const std::string& );
+   static const DOT_ATTR_ITEM_T* find( const DOT_ATTR_LIST_T& rList,
+                                       const std::string& rWord )
+   {
+      return rList.find( rWord.data(), rWord.size() );
+   }
 
    static const DOT_ATTR_ITEM_T* findNodeWord( const std::string& w )
    {
@@ -129,8 +188,12 @@ public:
       return find( c_graphAttributes, w );
    }
 
-   void list( const DOT_ATTR_LIST_T& rList, bool verbose );
+   void list( std::ostream& rOut, const DOT_ATTR_LIST_T& rList, bool verbose );
 
+private:
+   static const DOT_ATTR_ITEM_T c_edgeItems[];
+   static const DOT_ATTR_ITEM_T c_nodeItems[];
+   static const DOT_ATTR_ITEM_T c_graphItems[];
 };
 
 } // End namespace DocFsm
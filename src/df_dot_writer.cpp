@@ -0,0 +1,291 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!   @brief Module writes the DOT-output buffered into a file-descriptor    */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_dot_writer.cpp                                               */
+/*! @see     df_dot_writer.hpp                                               */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <map>
+
+#include "df_docfsm.hpp"
+#include "df_dot_writer.hpp"
+
+using namespace DocFsm;
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+DotWriter::OptionOutput::OptionOutput( DotWriter* pParent )
+   :m_pParent( pParent )
+{
+   m_hasArg   = REQUIRED_ARG;
+   m_shortOpt = 'o';
+   m_longOpt  = "output";
+   m_helpText = "Writes the DOT-output in the file PARAM instead of stdout.\n"
+                "E.g.: -o fsm.gv";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int DotWriter::OptionOutput::onGiven( CLOP::PARSER* poParser )
+{
+   if( poParser->getOptArg().empty() )
+   {
+      ERROR_MESSAGE( "Missing file name for DOT-output!" );
+      return -1;
+   }
+   m_pParent->m_fileName = poParser->getOptArg();
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+DotWriter::OptionOutputDir::OptionOutputDir( DotWriter* pParent )
+   :m_pParent( pParent )
+{
+   m_hasArg   = REQUIRED_ARG;
+   m_shortOpt = '\0';
+   m_longOpt  = "outdir";
+   m_helpText = "Batch mode: Writes for each source-file an own DOT-file\n"
+                "\"PARAM/<source-file without extension>.gv\" instead of\n"
+                "a merged graph to stdout. The directory PARAM has to exist.\n"
+                "Source-files which would get the same DOT-file like\n"
+                "\"a/fsm.c\" and \"b/fsm.cpp\" are refused.\n"
+                "E.g.: --outdir doc/fsm *.c";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int DotWriter::OptionOutputDir::onGiven( CLOP::PARSER* poParser )
+{
+   struct stat status;
+   const std::string& rDirectory = poParser->getOptArg();
+   if( rDirectory.empty() || (::stat( rDirectory.c_str(), &status ) != 0) ||
+       !S_ISDIR( status.st_mode ) )
+   {
+      ERROR_MESSAGE( "Output directory \"" << rDirectory << "\" not found!" );
+      return -1;
+   }
+   m_pParent->m_directory = rDirectory;
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+DotWriter::DotWriter( CommandlineParser& rParser )
+   :m_oOptionOutput( this )
+   ,m_oOptionOutputDir( this )
+   ,m_fd( STDOUT_FILENO )
+   ,m_pString( nullptr )
+   ,m_error( false )
+   ,m_bytes( 0 )
+   ,m_fill( 0 )
+   ,m_vBuffer( c_bufferSize )
+{
+   rParser( m_oOptionOutput )( m_oOptionOutputDir );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+DotWriter::DotWriter( int fd )
+   :m_oOptionOutput( this )
+   ,m_oOptionOutputDir( this )
+   ,m_fd( fd )
+   ,m_pString( nullptr )
+   ,m_error( false )
+   ,m_bytes( 0 )
+   ,m_fill( 0 )
+   ,m_vBuffer( c_bufferSize )
+{
+}
+
+/*!----------------------------------------------------------------------------
+*/
+DotWriter::DotWriter( std::string& rOutput )
+   :m_oOptionOutput( this )
+   ,m_oOptionOutputDir( this )
+   ,m_fd( -1 )
+   ,m_pString( &rOutput )
+   ,m_error( false )
+   ,m_bytes( 0 )
+   ,m_fill( 0 )
+   ,m_vBuffer( c_bufferSize )
+{
+}
+
+/*!----------------------------------------------------------------------------
+*/
+DotWriter::~DotWriter( void )
+{
+   close();
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool DotWriter::open( void )
+{
+   if( m_fileName.empty() )
+      return false;
+
+   m_fd = ::open( m_fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+   if( m_fd < 0 )
+   {
+      ERROR_MESSAGE( "Unable to open output file \"" << m_fileName << "\": "
+                     << ::strerror( errno ) );
+      m_error = true;
+      return true;
+   }
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool DotWriter::close( void )
+{
+   flush();
+   if( !m_fileName.empty() && (m_fd >= 0) )
+   {
+      if( ::close( m_fd ) != 0 )
+      {
+         ERROR_MESSAGE( "Unable to close output file \"" << m_fileName << "\": "
+                        << ::strerror( errno ) );
+         m_error = true;
+      }
+      m_fd = -1;
+   }
+   return m_error;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool DotWriter::flush( void )
+{
+   if( m_fill == 0 )
+      return m_error;
+   writeOut( m_vBuffer.data(), m_fill );
+   m_bytes += m_fill;
+   m_fill = 0;
+   return m_error;
+}
+
+/*!----------------------------------------------------------------------------
+ * Pieces which doesn't fit in the rest of the buffer.
+ */
+void DotWriter::writeLarge( const char* pData, std::size_t len )
+{
+   flush();
+   if( len < c_bufferSize )
+   {
+      ::memcpy( m_vBuffer.data(), pData, len );
+      m_fill = len;
+      return;
+   }
+   writeOut( pData, len );
+   m_bytes += len;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool DotWriter::writeOut( const char* pData, std::size_t len )
+{
+   if( m_pString != nullptr )
+   {
+      m_pString->append( pData, len );
+      return m_error;
+   }
+
+   while( !m_error && (len > 0) )
+   {
+      ssize_t n = ::write( m_fd, pData, len );
+      if( n < 0 )
+      {
+         if( errno == EINTR )
+            continue;
+         ERROR_MESSAGE( "Unable to write DOT-output: " << ::strerror( errno ) );
+         m_error = true;
+         break;
+      }
+      pData += n;
+      len   -= n;
+   }
+   return m_error;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void DotWriter::tabs( int n )
+{
+   static const char c_tabs[] = "\t\t\t\t\t\t\t\t";
+   while( n > 0 )
+   {
+      int part = (n < static_cast<int>(sizeof( c_tabs ) - 1))?
+                  n : static_cast<int>(sizeof( c_tabs ) - 1);
+      write( c_tabs, part );
+      n -= part;
+   }
+}
+
+/*!----------------------------------------------------------------------------
+*/
+DotWriter& DotWriter::operator<<( int n )
+{
+   char number[16];
+   int len = ::snprintf( number, sizeof( number ), "%d", n );
+   write( number, len );
+   return *this;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+std::string DotWriter::makeFileName( const std::string& rDirectory,
+                                     const std::string& rSourceFileName )
+{
+   std::string name = rSourceFileName;
+   std::size_t i = name.rfind( '/' );
+   if( i != std::string::npos )
+      name.erase( 0, i + 1 );
+   i = name.rfind( '.' );
+   if( (i != std::string::npos) && (i > 0) )
+      name.erase( i );
+   name += ".gv";
+
+   if( rDirectory.empty() )
+      return name;
+   if( rDirectory.back() == '/' )
+      return rDirectory + name;
+   return rDirectory + '/' + name;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool DotWriter::checkFileNames( const std::string& rDirectory,
+                                const FILE_NAME_LIST_T& rSourceFiles )
+{
+   std::map<std::string, const std::string*> targets;
+   for( const auto& rSourceFile : rSourceFiles )
+   {
+      const std::string dotFile = makeFileName( rDirectory, rSourceFile );
+      auto ret = targets.insert( std::make_pair( dotFile, &rSourceFile ) );
+      if( ret.second )
+         continue;
+      ERROR_MESSAGE( "Source-files \"" << *ret.first->second << "\" and \""
+                     << rSourceFile << "\" would be written in the same file \""
+                     << dotFile << "\"!" );
+      return true;
+   }
+   return false;
+}
+
+//================================== EOF ======================================
@@ -0,0 +1,204 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!   @brief Module writes the DOT-output buffered into a file-descriptor    */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_dot_writer.hpp                                               */
+/*! @see     df_dot_writer.cpp                                               */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#ifndef _DF_DOT_WRITER_HPP
+#define _DF_DOT_WRITER_HPP
+
+#ifndef __DOCFSM__
+ #include <string.h>
+ #include <string>
+ #include <vector>
+ #include "df_commandline.hpp"
+#endif
+
+namespace DocFsm
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Output of the DOT-code with a large buffer in user-space.
+ *
+ * The text becomes collected in the buffer and written by a few calls of
+ * write(2) directly into stdout respectively into the file given by the
+ * option "-o", without the overhead of std::ostream for each small piece.
+ *
+ * In the batch mode given by the option "--outdir" each source-file gets
+ * its own DOT-file in the given directory.
+ */
+class DotWriter
+{
+public:
+   using FILE_NAME_LIST_T = std::vector<std::string>;
+
+private:
+   static constexpr std::size_t c_bufferSize = 64 * 1024;
+
+   class OptionOutput: public CLOP::OPTION_V
+   {
+      DotWriter*   m_pParent;
+   public:
+      OptionOutput( DotWriter* pParent );
+      int onGiven( CLOP::PARSER* poParser ) override;
+   };
+
+   class OptionOutputDir: public CLOP::OPTION_V
+   {
+      DotWriter*   m_pParent;
+   public:
+      OptionOutputDir( DotWriter* pParent );
+      int onGiven( CLOP::PARSER* poParser ) override;
+   };
+
+   OptionOutput        m_oOptionOutput;
+   OptionOutputDir     m_oOptionOutputDir;
+   std::string         m_fileName;
+   std::string         m_directory;
+   int                 m_fd;
+   std::string*        m_pString;
+   bool                m_error;
+   std::size_t         m_bytes;
+   std::size_t         m_fill;
+   std::vector<char>   m_vBuffer;
+
+public:
+   /*!
+    * @brief Writes in stdout respectively in the file given by
+    *        the option "-o".
+    */
+   DotWriter( CommandlineParser& rParser );
+
+   /*!
+    * @brief Writes in the given already opened file-descriptor,
+    *        which will not closed by this object.
+    */
+   DotWriter( int fd );
+
+   /*!
+    * @brief Appends the output to the given string, e.g. for the
+    *        in-memory API of the class Extractor.
+    */
+   DotWriter( std::string& rOutput );
+
+   ~DotWriter( void );
+
+   /*!
+    * @brief Opens the output file if given by option.
+    * @retval true Error
+    */
+   bool open( void );
+
+   /*!
+    * @brief Opens the given output file, e.g. for each source-file in
+    *        the batch mode.
+    * @retval true Error
+    */
+   bool open( const std::string& rFileName )
+   {
+      m_fileName = rFileName;
+      return open();
+   }
+
+   /*!
+    * @brief Returns true if the option "--outdir" is given.
+    */
+   bool isBatch( void ) const { return !m_directory.empty(); }
+
+   /*!
+    * @brief Output file given by the option "-o", respectively the
+    *        last one given to open().
+    */
+   const std::string& getFileName( void ) const { return m_fileName; }
+
+   /*!
+    * @brief Output directory given by the option "--outdir".
+    */
+   const std::string& getDirectory( void ) const { return m_directory; }
+
+   /*!
+    * @brief Writes the rest of the buffer and closes the output file if
+    *        it was opened by open().
+    * @retval true Error, also if a previous write has been failed.
+    */
+   bool close( void );
+
+   /*!
+    * @brief Writes the content of the buffer.
+    * @retval true Error
+    */
+   bool flush( void );
+
+   /*!
+    * @brief Number of bytes written so far including the buffered ones.
+    */
+   std::size_t getBytes( void ) const { return m_bytes + m_fill; }
+
+   void write( const char* pData, std::size_t len )
+   {
+      if( len > c_bufferSize - m_fill )
+      {
+         writeLarge( pData, len );
+         return;
+      }
+      ::memcpy( &m_vBuffer[m_fill], pData, len );
+      m_fill += len;
+   }
+
+   /*!
+    * @brief Writes the given number of tabulators.
+    */
+   void tabs( int n );
+
+   DotWriter& operator<<( const std::string& rStr )
+   {
+      write( rStr.data(), rStr.size() );
+      return *this;
+   }
+
+   DotWriter& operator<<( const char* pStr )
+   {
+      write( pStr, ::strlen( pStr ) );
+      return *this;
+   }
+
+   DotWriter& operator<<( char c )
+   {
+      if( m_fill == c_bufferSize )
+         flush();
+      m_vBuffer[m_fill++] = c;
+      return *this;
+   }
+
+   DotWriter& operator<<( int n );
+
+   /*!
+    * @brief Name of the DOT-file for the given source-file within the
+    *        given directory: The extension of the source-file becomes
+    *        replaced by ".gv", e.g.: "src/fsm.c" -> "rDirectory/fsm.gv"
+    */
+   static std::string makeFileName( const std::string& rDirectory,
+                                    const std::string& rSourceFileName );
+
+   /*!
+    * @brief Checks whether several source-files would get the same
+    *        DOT-file by makeFileName(), e.g. "a/fsm.c" and "b/fsm.cpp".
+    * @retval true Error: At least two DOT-files would overwrite each other.
+    */
+   static bool checkFileNames( const std::string& rDirectory,
+                                  const FILE_NAME_LIST_T& rSourceFiles );
+
+private:
+   void writeLarge( const char* pData, std::size_t len );
+   bool writeOut( const char* pData, std::size_t len );
+};
+
+} // End namespace DocFsm
+#endif // ifndef _DF_DOT_WRITER_HPP
+//================================== EOF ======================================
@@ -21,7 +21,8 @@ using namespace DocFsm;
 ///////////////////////////////////////////////////////////////////////////////
 /*!----------------------------------------------------------------------------
 */
-void ATTR_LIST_T::generateTooltipFromLabel( const DotKeywords::DOT_ATTR_LIST_T& rList )
+void ATTR_LIST_T::generateTooltipFromLabel( Arena& rArena,
+                                            const DotKeywords::DOT_ATTR_LIST_T& rList )
 {
    for( const auto& pAttr: *this )
       if( DotKeywords::getId( pAttr->first ) == DotKeywords::TOOLTIP )
@@ -42,7 +43,7 @@ void ATTR_LIST_T::generateTooltipFromLabel( const DotKeywords::DOT_ATTR_LIST_T&
    const DotKeywords::DOT_ATTR_ITEM_T* pToolTip = DotKeywords::find( rList, "tooltip" );
    assert( pToolTip != nullptr );
 
-   std::string* pToolTipText = new std::string;
+   std::string* pToolTipText = rArena.create<std::string>();
 
    for( auto it = pLabelText->begin(); it != pLabelText->end(); it++ )
    {
@@ -55,7 +56,7 @@ void ATTR_LIST_T::generateTooltipFromLabel( const DotKeywords::DOT_ATTR_LIST_T&
          pToolTipText->push_back( *it );
    }
    pToolTipText->shrink_to_fit();
-   push_back( new ATTR_T( *pToolTip, pToolTipText ) );
+   push_back( rArena.create<ATTR_T>( *pToolTip, pToolTipText ) );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -74,25 +75,20 @@ void StateGraph::addClusterNumber( int n )
    }
    if( !labelPresent )
    {
-      m_vpAttributes.push_back( new ATTR_T( *m_pParent->getLabelAttribute(),
-                                    new std::string('"' + m_name + '"') ) );
+      Arena& rArena = m_pParent->getArena();
+      m_vpAttributes.push_back( rArena.create<ATTR_T>( *m_pParent->getLabelAttribute(),
+                                 rArena.create<std::string>( '"' + m_name + '"' ) ) );
    }
    m_clusterNumber = n;
+   m_dotName = m_name + '_' + std::to_string( n );
 }
 
 /*!----------------------------------------------------------------------------
 */
-void StateGraph::printName( std::ostream& rOut )
+void StateGraph::printState( DotWriter& rOut, const int tabs )
 {
-   rOut << m_name << '_' <<  m_clusterNumber;
-}
-
-/*!----------------------------------------------------------------------------
-*/
-void StateGraph::printState( std::ostream& rOut, const int tabs )
-{
-   StateCollector::printTabs( rOut, tabs );
-   printName( rOut );
+   rOut.tabs( tabs );
+   rOut << m_dotName;
 
    if( !m_vpAttributes.empty() )
       printAttr( rOut, m_vpAttributes );
@@ -102,7 +98,7 @@ void StateGraph::printState( std::ostream& rOut, const int tabs )
 
 /*!----------------------------------------------------------------------------
 */
-void StateGraph::printTransitions( std::ostream& rOut, const int tabs )
+void StateGraph::printTransitions( DotWriter& rOut, const int tabs )
 {
    if( m_pParent->noTransitions() )
       return;
@@ -110,10 +106,8 @@ void StateGraph::printTransitions( std::ostream& rOut, const int tabs )
 #ifdef CONFIG_PRINT_CALLER_LIST
    for( const auto& pCaller : m_vpCallerList )
    {
-      StateCollector::printTabs( rOut, tabs );
-      pCaller->getState()->printName( rOut );
-      rOut << " -> ";
-      printName( rOut );
+      rOut.tabs( tabs );
+      rOut << pCaller->getState()->getDotName() << " -> " << m_dotName;
       if( !pCaller->getTransition()->getAttrList().empty() )
          printAttr( rOut, pCaller->getTransition()->getAttrList(),
                     !m_pParent->noTransitionLabels() );
@@ -122,10 +116,8 @@ void StateGraph::printTransitions( std::ostream& rOut, const int tabs )
 #else
    for( const auto& pTransition : m_vpTransitions )
    {
-      StateCollector::printTabs( rOut, tabs );
-      printName( rOut );
-      rOut << " -> ";
-      pTransition->getTargetState()->printName( rOut );
+      rOut.tabs( tabs );
+      rOut << m_dotName << " -> " << pTransition->getTargetState()->getDotName();
       if( !pTransition->getAttrList().empty() )
          printAttr( rOut, pTransition->getAttrList(),
             !m_pParent->noTransitionLabels() );
@@ -137,7 +129,7 @@ void StateGraph::printTransitions( std::ostream& rOut, const int tabs )
 
 /*!----------------------------------------------------------------------------
 */
-void StateGraph::printAttr( std::ostream& rOut, const ATTR_LIST_T& rvpAttributes,
+void StateGraph::printAttr( DotWriter& rOut, const ATTR_LIST_T& rvpAttributes,
                             bool printLabel )
 {
    bool next = false;
@@ -162,100 +154,33 @@ void StateGraph::printAttr( std::ostream& rOut, const ATTR_LIST_T& rvpAttributes
 */
 void StateGraph::addAttribute( const std::string& rKey, const std::string& rValue )
 {
-   m_vpAttributes.push_back( makeAttribute( DotKeywords::c_nodeAttributes, rKey, rValue ) );
+   m_vpAttributes.push_back( makeAttribute( m_pParent->getArena(),
+                                            DotKeywords::c_nodeAttributes,
+                                            rKey, rValue ) );
 }
 
+#ifdef CONFIG_PRINT_CALLER_LIST
 /*!----------------------------------------------------------------------------
+ * @note The transitions and attributes are owned by the arena of the
+ *       StateCollector.
 */
 StateGraph::~StateGraph( void )
 {
-   DEBUG_MESSAGE( "Destructor of \"" << m_name << "\"" );
-   for( const auto& pTransition : m_vpTransitions )
-   {
-      for( const auto& pAttribute : pTransition->getAttrList() )
-      {
-         if( pAttribute->second != nullptr )
-            delete pAttribute->second;
-         delete pAttribute;
-      }
-      delete pTransition;
-   }
-#ifdef CONFIG_PRINT_CALLER_LIST
    for( const auto& pCaller : m_vpCallerList )
       delete pCaller;
-#endif
 }
+#endif
 
 /*!----------------------------------------------------------------------------
 */
-const ATTR_T* StateGraph::makeAttribute( const DotKeywords::DOT_ATTR_LIST_T& rAttrGroup,
+const ATTR_T* StateGraph::makeAttribute( Arena& rArena,
+                                   const DotKeywords::DOT_ATTR_LIST_T& rAttrGroup,
                                    const std::string& rKey,
                                    const std::string& rValue )
 {
    const DotKeywords::DOT_ATTR_ITEM_T* pAttr = DotKeywords::find( rAttrGroup, rKey );
    assert( pAttr != nullptr );
-   return new ATTR_T( *pAttr, new std::string(rValue) );
-}
-
-/*!----------------------------------------------------------------------------
- * @note Recursive call
- */
-void StateGraph::setFsm( int fsmNumber )
-{
-    assert( fsmNumber > 0 );
-
-    if( m_fsmNumber == 0 )
-    {
-       DEBUG_MESSAGE( "Set fsmNumber-number " << fsmNumber << " for " << m_name );
-       m_fsmNumber = fsmNumber;
-       for( auto& pTransition : m_vpTransitions )
-          pTransition->getTargetState()->setFsm( fsmNumber );
-    }
-}
-
-/*!----------------------------------------------------------------------------
- * @note Recursive call
- */
-bool StateGraph::_obtainFsmNumberIfEqual( int fsmNumber )
-{
-    if( fsmNumber == m_fsmNumber )
-       return true;
-
-    if( m_fsmNumber != 0 )
-       return false;
- 
-    if( m_visited )
-       return false;
-    m_visited = true;
-
-    bool ret = false;
-    for( const auto& pTransition : m_vpTransitions )
-    {
-       assert( dynamic_cast<StateGraph*>(pTransition->getTargetState()) != nullptr );
-       DEBUG_MESSAGE( "Name " << m_name );
-       if( pTransition->getTargetState() == this )
-           continue;
-       if( pTransition->getTargetState()->_obtainFsmNumberIfEqual( fsmNumber ) )
-       {
-          DEBUG_MESSAGE( "obtain fsmNumber-number " << fsmNumber << " for " << m_name );
-          m_fsmNumber = fsmNumber;
-          ret = true;
-       }
-    }
-    if( m_fsmNumber == 0 )
-        return ret;
-    for( const auto& pTransition : m_vpTransitions )
-    {
-       if( pTransition->getTargetState() == this )
-          continue;
-       if( pTransition->getTargetState()->m_fsmNumber == 0 )
-       {
-          DEBUG_MESSAGE( "set fsmNumber-number " << m_fsmNumber << " from " <<
-                          m_name << " to " << pTransition->getTargetState()->m_name );
-          pTransition->getTargetState()->m_fsmNumber = m_fsmNumber;
-       }
-    }
-    return ret;
+   return rArena.create<ATTR_T>( *pAttr, rArena.create<std::string>( rValue ) );
 }
 
 /*!----------------------------------------------------------------------------
@@ -273,12 +198,20 @@ std::string* StateGraph::findGroupName( void )
    return nullptr;
 }
 
+/*!----------------------------------------------------------------------------
+*/
+void StateGraph::generateStateTooltipFromLabel( void )
+{
+   m_vpAttributes.generateTooltipFromLabel( m_pParent->getArena(),
+                                            DotKeywords::c_nodeAttributes );
+}
+
 /*!----------------------------------------------------------------------------
 */
 void StateGraph::generateTransitionTooltipFromLabel( void )
 {
    for( const auto& pTransition: m_vpTransitions )
-      pTransition->generateTooltipFromLabel();
+      pTransition->generateTooltipFromLabel( m_pParent->getArena() );
 }
 
 //================================== EOF ======================================
@@ -16,6 +16,8 @@
  #include <assert.h>
  #include "df_keyword.hpp"
  #include "df_dot_keywords.hpp"
+ #include "df_arena.hpp"
+ #include "df_dot_writer.hpp"
 #endif
 
 namespace DocFsm
@@ -27,7 +29,7 @@ using ATTR_T = std::pair< const DotKeywords::DOT_ATTR_ITEM_T&, std::string* >;
 class ATTR_LIST_T: public std::vector< const ATTR_T* >
 {
 public:
-   void generateTooltipFromLabel( const DotKeywords::DOT_ATTR_LIST_T& );
+   void generateTooltipFromLabel( Arena&, const DotKeywords::DOT_ATTR_LIST_T& );
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -44,9 +46,9 @@ public:
    {}
    ATTR_LIST_T& getAttrList( void ) { return m_vpAttributes; }
    StateGraph*  getTargetState( void ) { return m_pTargetState; }
-   void generateTooltipFromLabel( void )
+   void generateTooltipFromLabel( Arena& rArena )
    {
-      m_vpAttributes.generateTooltipFromLabel( DotKeywords::c_edgeAttributes );
+      m_vpAttributes.generateTooltipFromLabel( rArena, DotKeywords::c_edgeAttributes );
    }
 };
 
@@ -80,8 +82,8 @@ private:
    StateCollector*               m_pParent;
    int                           m_fsmNumber;
    int                           m_clusterNumber;
-   bool                          m_visited;
    std::string                   m_name;
+   std::string                   m_dotName;
    TRANSITION_LIST_T             m_vpTransitions;
    ATTR_LIST_T                   m_vpAttributes;
 #ifdef CONFIG_PRINT_CALLER_LIST
@@ -93,26 +95,27 @@ public:
       :m_pParent( pParent )
       ,m_fsmNumber( 0 )
       ,m_clusterNumber( 0 )
-      ,m_visited( false )
       ,m_name( name )
+      ,m_dotName( name + "_0" )
    {}
+#ifdef CONFIG_PRINT_CALLER_LIST
    ~StateGraph( void );
+#endif
 
-   void printState( std::ostream&, const int=0 );
-   void printTransitions( std::ostream&, const int=0 );
-   static void printAttr( std::ostream& rOut, const ATTR_LIST_T&, bool=true );
+   void printState( DotWriter&, const int=0 );
+   void printTransitions( DotWriter&, const int=0 );
+   static void printAttr( DotWriter& rOut, const ATTR_LIST_T&, bool=true );
    void addAttribute( const std::string& rKey, const std::string& rValue );
    void addClusterNumber( int n );
 
-   static const ATTR_T* makeAttribute( const DotKeywords::DOT_ATTR_LIST_T&,
+   static const ATTR_T* makeAttribute( Arena&, const DotKeywords::DOT_ATTR_LIST_T&,
                                  const std::string& rKey,
                                  const std::string& rValue );
 
-   void setFsm( int fsmNumber );
-   bool obtainFsmNumberIfEqual( int fsmNumber )
+   void setFsm( int fsmNumber )
    {
-      m_visited = false;
-      return _obtainFsmNumberIfEqual( fsmNumber );
+      assert( fsmNumber > 0 );
+      m_fsmNumber = fsmNumber;
    }
 
    std::string* findGroupName( void );
@@ -148,16 +151,15 @@ public:
    int getFsmNumber( void ) const { return m_fsmNumber; }
    ATTR_LIST_T& getAttrList( void ) { return m_vpAttributes; }
 
-   void generateStateTooltipFromLabel( void )
-   {
-      m_vpAttributes.generateTooltipFromLabel( DotKeywords::c_nodeAttributes );
-   }
+   void generateStateTooltipFromLabel( void );
 
    void generateTransitionTooltipFromLabel( void );
 
 private:
-   bool _obtainFsmNumberIfEqual( int fsmNumber );
-   void printName( std::ostream& rOut );
+   /*!
+    * @brief Name of the node in the DOT-output: "<name>_<cluster number>".
+    */
+   const std::string& getDotName( void ) const { return m_dotName; }
 };
 
 } // End namespace DocFsm
@@ -0,0 +1,193 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!     @brief Module provides DocFsm as library with an in-memory API      */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_extractor.cpp                                                */
+/*! @see     df_extractor.hpp                                                */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#include "df_docfsm.hpp"
+#include "df_preparser.hpp"
+#include "df_dot_writer.hpp"
+#include "df_extractor.hpp"
+
+using namespace DocFsm;
+
+/*!----------------------------------------------------------------------------
+ * @brief Arguments for the command line parser: The name of the program
+ *        followed by the given options.
+ */
+static ExtractorConfig::OPTION_LIST_T makeArgs( const ExtractorConfig::OPTION_LIST_T& rOptions )
+{
+   ExtractorConfig::OPTION_LIST_T args;
+   args.reserve( rOptions.size() + 1 );
+   args.push_back( "docfsm" );
+   args.insert( args.end(), rOptions.begin(), rOptions.end() );
+   return args;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Argument vector terminated by nullptr like in main().
+ */
+static std::vector<char*> makeArgv( ExtractorConfig::OPTION_LIST_T& rArgs )
+{
+   std::vector<char*> argv;
+   argv.reserve( rArgs.size() + 1 );
+   for( auto& rArg : rArgs )
+      argv.push_back( &rArg[0] );
+   argv.push_back( nullptr );
+   return argv;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+ExtractorConfig::ExtractorConfig( const OPTION_LIST_T& rOptions )
+   :m_vArgs( makeArgs( rOptions ) )
+   ,m_vpArgv( makeArgv( m_vArgs ) )
+   ,m_oCommandlineParser( static_cast<int>(m_vArgs.size()), m_vpArgv.data(), m_info )
+   ,m_oKeywordPool( m_oCommandlineParser )
+   ,m_oCppCaller( m_cppOutput, m_oCommandlineParser )
+   ,m_oSourceBrowser( m_source )
+   ,m_oCollector( m_oSourceBrowser, m_oKeywordPool, m_oCommandlineParser )
+   ,m_oTransitionFinder( m_oCollector, m_oCommandlineParser )
+   ,m_oDotKeywords( m_oCommandlineParser )
+   ,m_valid( false )
+{
+   if( m_oCommandlineParser() < 0 )
+      return;
+
+   /*
+    * Freezes the keyword lookup, from here on the keyword pool
+    * becomes only read.
+    */
+   if( m_oKeywordPool.setDefaultsIfEmpty() )
+      return;
+
+   m_valid = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+Extractor::Extractor( const OPTION_LIST_T& rOptions )
+   :m_poOwnConfig( new ExtractorConfig( rOptions ) )
+   ,m_rConfig( *m_poOwnConfig )
+   ,m_errStream( &m_errBuffer )
+   ,m_oCpp( m_rConfig.getCppCaller(), m_cppOutput, m_errStream )
+   ,m_oSourceBrowser( m_source )
+   ,m_oCollector( m_rConfig.getCollector(), m_oSourceBrowser )
+   ,m_oTransitionFinder( m_rConfig.getTransitionFinder(), m_oCollector )
+   ,m_valid( false )
+{
+   addConfigFiles();
+}
+
+/*!----------------------------------------------------------------------------
+*/
+Extractor::Extractor( const ExtractorConfig& rConfig )
+   :m_rConfig( rConfig )
+   ,m_errStream( &m_errBuffer )
+   ,m_oCpp( m_rConfig.getCppCaller(), m_cppOutput, m_errStream )
+   ,m_oSourceBrowser( m_source )
+   ,m_oCollector( m_rConfig.getCollector(), m_oSourceBrowser )
+   ,m_oTransitionFinder( m_rConfig.getTransitionFinder(), m_oCollector )
+   ,m_valid( false )
+{
+   addConfigFiles();
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void Extractor::addConfigFiles( void )
+{
+   if( !m_rConfig.isValid() )
+      return;
+
+   for( const auto& rFileName : m_rConfig.getFileNameList() )
+   {
+      if( addFile( rFileName ) )
+         return;
+   }
+   m_valid = true;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool Extractor::addSource( const std::string& rName, const std::string& rSource )
+{
+   m_cppOutput.clear();
+   const bool error = m_oCpp.preprocess( rName, rSource );
+   flushErrors();
+   if( error )
+      return true;
+   return collect( rName );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool Extractor::addFile( const std::string& rFileName )
+{
+   m_cppOutput.clear();
+   const bool error = m_oCpp.preprocess( rFileName );
+   flushErrors();
+   if( error )
+      return true;
+   return collect( rFileName );
+}
+
+/*!----------------------------------------------------------------------------
+ * Each message becomes written by one operation, so the messages of
+ * concurrently running objects will not mixed.
+ */
+void Extractor::flushErrors( void )
+{
+   if( m_errBuffer.in_avail() <= 0 )
+      return;
+   std::cerr << m_errBuffer.str() << std::flush;
+   m_errBuffer.str( std::string() );
+}
+
+/*!----------------------------------------------------------------------------
+ * Same steps as the program does for each source-file.
+ */
+bool Extractor::collect( const std::string& rName )
+{
+   m_source.clear();
+   Preparser preparser( m_cppOutput, m_source );
+   if( preparser() )
+      return true;
+
+   m_names.push_back( rName );
+   m_oTransitionFinder.resetContext();
+   if( m_oCollector( m_names.back() ) )
+      return true;
+
+   return !m_oCollector.isEmpty() && m_oTransitionFinder();
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool Extractor::getDot( std::string& rDot )
+{
+   DotWriter dotWriter( rDot );
+
+   m_oCollector.splitInClusters();
+   m_oCollector.splitInGroups();
+   m_oCollector.generateTooltipFromLabel();
+   m_oCollector.print( dotWriter );
+   return dotWriter.close();
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void Extractor::clear( void )
+{
+   m_oCollector.clear();
+   m_names.clear();
+}
+
+//================================== EOF ======================================
@@ -0,0 +1,246 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!     @brief Module provides DocFsm as library with an in-memory API      */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_extractor.hpp                                                */
+/*! @see     df_extractor.cpp                                                */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#ifndef _DF_EXTRACTOR_HPP
+#define _DF_EXTRACTOR_HPP
+
+#ifndef __DOCFSM__
+ #include <string>
+ #include <vector>
+ #include <list>
+ #include <memory>
+ #include <sstream>
+ #include "df_commandline.hpp"
+ #include "df_keyword_pool.hpp"
+ #include "df_cpp_caller.hpp"
+ #include "df_state_collector.hpp"
+ #include "df_transition_finder.hpp"
+ #include "df_dot_keywords.hpp"
+#endif
+
+namespace DocFsm
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Configuration of the class Extractor given by options.
+ *
+ * The options are the same as of the command line of the program docfsm,
+ * except of the options for the output-files, the model-cache, the
+ * statistics, the worker threads and the operating modes like "--server"
+ * or "--watch", which are unknown here.
+ *
+ * After the construction the object becomes not changed anymore, so it
+ * can be shared by several Extractor objects in several threads. It has
+ * to exist as long as the Extractor objects which use it.
+ */
+class ExtractorConfig
+{
+public:
+   using OPTION_LIST_T = std::vector<std::string>;
+
+private:
+   /*!
+    * @brief Storage of the arguments for the command line parser, which
+    *        keeps only pointers to them.
+    */
+   OPTION_LIST_T            m_vArgs;
+   std::vector<char*>       m_vpArgv;
+   std::ostringstream       m_info;
+   CommandlineParser        m_oCommandlineParser;
+   KeywordPool              m_oKeywordPool;
+   std::string              m_cppOutput;
+   std::string              m_source;
+   CppCaller                m_oCppCaller;
+   /*!
+    * @brief Prototypes which receive the options, they never collect.
+    */
+   SourceBrowser            m_oSourceBrowser;
+   StateCollector           m_oCollector;
+   TransitionFinder         m_oTransitionFinder;
+   DotKeywords              m_oDotKeywords;
+   bool                     m_valid;
+
+public:
+   /*!
+    * @param rOptions Options like of the command line, without the name
+    *                 of the program.
+    */
+   ExtractorConfig( const OPTION_LIST_T& rOptions = OPTION_LIST_T() );
+
+   /*!
+    * @brief Returns false if the options were invalid or if an
+    *        information option like "--help" was given.
+    */
+   bool isValid( void ) const { return m_valid; }
+
+   /*!
+    * @brief Output of the information options like "--help" or "--version".
+    */
+   std::string getInfo( void ) const { return m_info.str(); }
+
+   /*!
+    * @brief Source-files given in the options.
+    */
+   const OPTION_LIST_T& getFileNameList( void ) const
+   {
+      return m_oCommandlineParser.getFileNameList();
+   }
+
+   const CppCaller& getCppCaller( void ) const { return m_oCppCaller; }
+   const StateCollector& getCollector( void ) const { return m_oCollector; }
+   const TransitionFinder& getTransitionFinder( void ) const
+   {
+      return m_oTransitionFinder;
+   }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Extraction of the state machines from source-code given in memory
+ *        or by file, for using DocFsm as library "libdocfsm" e.g. in an
+ *        IDE-plugin or in a documentation generator.
+ *
+ * All sources which have been added become merged to one graph, like the
+ * source-files of a command line.
+ *
+ * Each object holds its own parse context: the buffers, the preprocessor
+ * and the model. The configuration is shared read-only, so several objects
+ * created from the same ExtractorConfig can extract concurrently, one per
+ * thread. A single object must not be used by several threads at once.
+ *
+ * Errors and warnings become written in stderr, like by the program.
+ *
+ * @code
+ * DocFsm::Extractor extractor( { "-E", "color=blue" } );
+ * if( !extractor.isValid() )
+ *    return 1;
+ * if( extractor.addSource( "fsm.c", source ) )
+ *    return 1;
+ * DocFsm::Extractor::STATE_LIST_T states;
+ * extractor.getStates( states );
+ * std::string dot;
+ * extractor.getDot( dot );
+ * @endcode
+ *
+ * Concurrently in several threads:
+ * @code
+ * const DocFsm::ExtractorConfig config( { "-E", "color=blue" } );
+ * // In each thread:
+ * DocFsm::Extractor extractor( config );
+ * @endcode
+ */
+class Extractor
+{
+public:
+   using OPTION_LIST_T = ExtractorConfig::OPTION_LIST_T;
+   using STATE_LIST_T  = StateCollector::STATE_LIST_T;
+
+private:
+   std::unique_ptr<ExtractorConfig> m_poOwnConfig;
+   const ExtractorConfig&   m_rConfig;
+   std::string              m_cppOutput;
+   std::string              m_source;
+   /*!
+    * @brief Own stream for the messages of the preprocessor, because
+    *        the CppCache redirects it temporary.
+    */
+   std::stringbuf           m_errBuffer;
+   std::ostream             m_errStream;
+   CppProcess               m_oCpp;
+   SourceBrowser            m_oSourceBrowser;
+   StateCollector           m_oCollector;
+   TransitionFinder         m_oTransitionFinder;
+   /*!
+    * @brief Names of the added sources, a module keeps only a reference
+    *        to its name.
+    */
+   std::list<std::string>   m_names;
+   bool                     m_valid;
+
+public:
+   /*!
+    * @brief Extractor with its own configuration.
+    * @param rOptions Options like of the command line, without the name
+    *                 of the program. Given source-files become added
+    *                 like by addFile().
+    */
+   Extractor( const OPTION_LIST_T& rOptions = OPTION_LIST_T() );
+
+   /*!
+    * @brief Extractor with a shared configuration, source-files given in
+    *        its options become added like by addFile().
+    */
+   Extractor( const ExtractorConfig& rConfig );
+
+   /*!
+    * @brief Returns false if the options were invalid, if an information
+    *        option like "--help" was given or if a source-file of the
+    *        options could not be added.
+    */
+   bool isValid( void ) const { return m_valid; }
+
+   /*!
+    * @brief Output of the information options like "--help" or "--version".
+    */
+   std::string getInfo( void ) const { return m_rConfig.getInfo(); }
+
+   /*!
+    * @brief Adds the state machines of the given source-code.
+    *
+    * The source-code becomes preprocessed by the built-in preprocessor.
+    * @param rName   Name of the source, used for the messages, for the
+    *                flags from a compilation database and for resolving
+    *                quoted includes.
+    * @param rSource Source-code
+    * @retval true Error
+    */
+   bool addSource( const std::string& rName, const std::string& rSource );
+
+   /*!
+    * @brief Adds the state machines of the given source-file, preprocessed
+    *        like by the program.
+    * @retval true Error
+    */
+   bool addFile( const std::string& rFileName );
+
+   /*!
+    * @brief Appends all states found so far to rStates. The objects
+    *        remain owned by this object until clear().
+    */
+   void getStates( STATE_LIST_T& rStates ) const
+   {
+      m_oCollector.getAllStates( rStates );
+   }
+
+   /*!
+    * @brief Appends the DOT-code of all state machines found so far
+    *        to rDot.
+    * @note The states become split in clusters and groups as for the
+    *       output, so further sources have to be added after clear() only.
+    * @retval true Error
+    */
+   bool getDot( std::string& rDot );
+
+   /*!
+    * @brief Removes all states found so far, the configuration remains.
+    */
+   void clear( void );
+
+private:
+   void addConfigFiles( void );
+   void flushErrors( void );
+   bool collect( const std::string& rName );
+};
+
+} // End namespace DocFsm
+#endif // ifndef _DF_EXTRACTOR_HPP
+//================================== EOF ======================================
@@ -0,0 +1,512 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!    @brief Module generates synthetic C-sources containing FSMs for       */
+/*!           benchmarking DocFsm.                                           */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_fsm_generator.cpp                                            */
+/*! @see     df_fsm_generator.hpp                                            */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#ifndef __DOCFSM__
+ #include <stdlib.h>
+ #include <fstream>
+#endif
+#include "df_docfsm.hpp"
+#include "df_fsm_generator.hpp"
+
+using namespace DocFsm;
+
+/*!
+ * @brief Attributes for the state declarations, the first N will used.
+ */
+static const char* const c_stateAttributes[] =
+{
+   "color=red",
+   "style=filled",
+   "fillcolor=yellow",
+   "shape=box",
+   "fontcolor=blue",
+   "penwidth=2"
+};
+
+/*!
+ * @brief Attributes for the transitions, the first N will used.
+ */
+static const char* const c_transitionAttributes[] =
+{
+   "color=blue",
+   "style=dashed",
+   "fontcolor=red",
+   "arrowhead=vee",
+   "penwidth=2",
+   "weight=2"
+};
+
+#define ARRAY_SIZE( a ) (sizeof( a ) / sizeof( a[0] ))
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+bool FsmGenerator::Option::getNumber( CLOP::PARSER* poParser,
+                                      unsigned int& rNumber )
+{
+   char* pEnd;
+   long number = ::strtol( poParser->getOptArg().c_str(), &pEnd, 10 );
+   if( poParser->getOptArg().empty() || (*pEnd != '\0') || (number < 0) )
+   {
+      ERROR_MESSAGE( "Invalid number: \"" << poParser->getOptArg() << "\"" );
+      return true;
+   }
+   rNumber = number;
+   return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+FsmGenerator::OptionFiles::OptionFiles( FsmGenerator* pParent )
+   :Option( pParent )
+{
+   m_longOpt  = "gen-files";
+   m_helpText = "Number of source-files to generate. Default: 10";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int FsmGenerator::OptionFiles::onGiven( CLOP::PARSER* poParser )
+{
+   if( getNumber( poParser, m_pParent->m_files ) )
+   {
+      ::exit( EXIT_FAILURE );
+      return -1;
+   }
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+FsmGenerator::OptionStates::OptionStates( FsmGenerator* pParent )
+   :Option( pParent )
+{
+   m_longOpt  = "gen-states";
+   m_helpText = "Number of states of each generated FSM. Default: 20";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int FsmGenerator::OptionStates::onGiven( CLOP::PARSER* poParser )
+{
+   if( getNumber( poParser, m_pParent->m_states ) || (m_pParent->m_states == 0) )
+   {
+      ERROR_MESSAGE( "At least one state is necessary!" );
+      ::exit( EXIT_FAILURE );
+      return -1;
+   }
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+FsmGenerator::OptionTransitions::OptionTransitions( FsmGenerator* pParent )
+   :Option( pParent )
+{
+   m_longOpt  = "gen-transitions";
+   m_helpText = "Number of transitions of each generated state. Default: 3";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int FsmGenerator::OptionTransitions::onGiven( CLOP::PARSER* poParser )
+{
+   if( getNumber( poParser, m_pParent->m_transitions ) )
+   {
+      ::exit( EXIT_FAILURE );
+      return -1;
+   }
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+FsmGenerator::OptionAttributes::OptionAttributes( FsmGenerator* pParent )
+   :Option( pParent )
+{
+   m_longOpt  = "gen-attributes";
+   m_helpText = "Number of DOT-attributes of each generated state and transition\n"
+                "additional to the label. Maximum: 6, default: 2";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int FsmGenerator::OptionAttributes::onGiven( CLOP::PARSER* poParser )
+{
+   if( getNumber( poParser, m_pParent->m_attributes ) )
+   {
+      ::exit( EXIT_FAILURE );
+      return -1;
+   }
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+FsmGenerator::OptionNesting::OptionNesting( FsmGenerator* pParent )
+   :Option( pParent )
+{
+   m_longOpt  = "gen-nesting";
+   m_helpText = "Depth of nested blocks around each generated transition.\n"
+                "Default: 1";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int FsmGenerator::OptionNesting::onGiven( CLOP::PARSER* poParser )
+{
+   if( getNumber( poParser, m_pParent->m_nesting ) )
+   {
+      ::exit( EXIT_FAILURE );
+      return -1;
+   }
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+FsmGenerator::OptionStyle::OptionStyle( FsmGenerator* pParent )
+   :Option( pParent )
+{
+   m_longOpt  = "gen-style";
+   m_helpText = "Style of the generated FSMs, PARAM is one of:\n"
+                "\"switch\", \"funcptr\", \"entryexit\" or \"mixed\".\n"
+                "Default: mixed";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int FsmGenerator::OptionStyle::onGiven( CLOP::PARSER* poParser )
+{
+   const std::string& rStyle = poParser->getOptArg();
+   if( rStyle == "switch" )
+      m_pParent->m_style = SWITCH_CASE;
+   else if( rStyle == "funcptr" )
+      m_pParent->m_style = FUNCTION_POINTER;
+   else if( rStyle == "entryexit" )
+      m_pParent->m_style = ENTRY_EXIT;
+   else if( rStyle == "mixed" )
+      m_pParent->m_style = MIXED;
+   else
+   {
+      ERROR_MESSAGE( "Unknown FSM-style: \"" << rStyle << "\"" );
+      ::exit( EXIT_FAILURE );
+      return -1;
+   }
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+FsmGenerator::OptionDirectory::OptionDirectory( FsmGenerator* pParent )
+   :Option( pParent )
+{
+   m_longOpt  = "gen-dir";
+   m_helpText = "Existing directory for the generated files, they will kept\n"
+                "after the benchmark. Without this option a temporary\n"
+                "directory will used and removed afterwards.";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int FsmGenerator::OptionDirectory::onGiven( CLOP::PARSER* poParser )
+{
+   m_pParent->m_directory = poParser->getOptArg();
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+FsmGenerator::FsmGenerator( CommandlineParser& rParser )
+   :m_oOptionFiles( this )
+   ,m_oOptionStates( this )
+   ,m_oOptionTransitions( this )
+   ,m_oOptionAttributes( this )
+   ,m_oOptionNesting( this )
+   ,m_oOptionStyle( this )
+   ,m_oOptionDirectory( this )
+   ,m_files( 10 )
+   ,m_states( 20 )
+   ,m_transitions( 3 )
+   ,m_attributes( 2 )
+   ,m_nesting( 1 )
+   ,m_style( MIXED )
+{
+   rParser( m_oOptionFiles )
+          ( m_oOptionStates )
+          ( m_oOptionTransitions )
+          ( m_oOptionAttributes )
+          ( m_oOptionNesting )
+          ( m_oOptionStyle )
+          ( m_oOptionDirectory );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool FsmGenerator::generate( const std::string& rDirectory,
+                             FILE_NAME_LIST_T& rFiles )
+{
+   m_random.seed( 1 );
+   for( unsigned int i = 0; i < m_files; i++ )
+   {
+      const std::string name = rDirectory + "/fsm" + std::to_string( i ) + ".c";
+      std::ofstream file( name.c_str() );
+      if( !file )
+      {
+         ERROR_MESSAGE( "Unable to create file: \"" << name << "\"" );
+         return true;
+      }
+      generateFile( file, i, (m_style == MIXED)? static_cast<STYLE_T>( i % MIXED ) : m_style );
+      file.close();
+      if( !file )
+      {
+         ERROR_MESSAGE( "Unable to write file: \"" << name << "\"" );
+         return true;
+      }
+      rFiles.push_back( name );
+   }
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void FsmGenerator::generateFile( std::ostream& rOut, unsigned int fileNumber,
+                                 STYLE_T style )
+{
+   const std::string prefix = "f" + std::to_string( fileNumber ) + "_";
+
+   rOut << "/* Generated by docfsm_bench */\n"
+           "#include <stdio.h>\n\n";
+
+   switch( style )
+   {
+      case SWITCH_CASE:
+      {
+         writeSwitchCase( rOut, prefix, false );
+         break;
+      }
+      case ENTRY_EXIT:
+      {
+         writeSwitchCase( rOut, prefix, true );
+         break;
+      }
+      default:
+      {
+         writeFunctionPointer( rOut, prefix );
+         break;
+      }
+   }
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void FsmGenerator::writeSwitchCase( std::ostream& rOut,
+                                    const std::string& rPrefix,
+                                    bool withEntryExit )
+{
+   const char* declare = withEntryExit? "FSM_DECLARE_STATE_XE" : "FSM_DECLARE_STATE";
+
+   rOut << "#define " << declare << "( name, attr... ) name\n"
+           "#define FSM_TRANSITION( _newState, attr... ) pFsm->newState = _newState\n"
+           "#define FSM_TRANSITION_SELF( attr... )\n"
+           "#define FSM_INIT_FSM( fsm, startState, attr... ) fsm.newState = startState\n\n"
+           "typedef enum\n{\n"
+           "   " << rPrefix << "NO_STATE";
+   for( unsigned int i = 0; i < m_states; i++ )
+   {
+      rOut << ",\n   " << declare << "( " << stateName( rPrefix, i );
+      writeAttributes( rOut, true, i );
+      rOut << " )";
+   }
+   rOut << "\n} " << rPrefix << "STATE_T;\n\n"
+           "struct " << rPrefix << "FSM_T\n{\n"
+           "   " << rPrefix << "STATE_T newState;\n"
+           "   " << rPrefix << "STATE_T currentState;\n"
+           "   int counter;\n};\n\n"
+           "void " << rPrefix << "executeFsm( struct " << rPrefix << "FSM_T* pFsm )\n{\n";
+
+   if( withEntryExit )
+   {
+      rOut << "   if( pFsm->newState != pFsm->currentState )\n   {\n"
+              "      switch( pFsm->newState ) /* Entry actions */\n      {\n";
+      for( unsigned int i = 0; i < m_states; i++ )
+      {
+         rOut << "         case " << stateName( rPrefix, i ) << ":\n         {\n"
+                 "            pFsm->counter = " << i << ";\n"
+                 "            break;\n         }\n";
+      }
+      rOut << "         default: break;\n      }\n"
+              "      pFsm->currentState = pFsm->newState;\n   }\n\n";
+   }
+
+   rOut << "   switch( pFsm->currentState ) /* Do actions */\n   {\n";
+   for( unsigned int i = 0; i < m_states; i++ )
+   {
+      rOut << "      case " << stateName( rPrefix, i ) << ":\n      {\n"
+              "         printf( \"do " << stateName( rPrefix, i ) << "\\n\" );\n";
+      writeTransitions( rOut, rPrefix, i, 3, "pFsm->counter" );
+      rOut << "         FSM_TRANSITION_SELF( label='idle' );\n"
+              "         break;\n      }\n";
+   }
+   rOut << "      default: break;\n   }\n";
+
+   if( withEntryExit )
+   {
+      rOut << "\n   if( pFsm->newState != pFsm->currentState )\n   {\n"
+              "      switch( pFsm->currentState ) /* Exit actions */\n      {\n";
+      for( unsigned int i = 0; i < m_states; i++ )
+      {
+         rOut << "         case " << stateName( rPrefix, i ) << ":\n         {\n"
+                 "            printf( \"exit " << stateName( rPrefix, i ) << "\\n\" );\n"
+                 "            break;\n         }\n";
+      }
+      rOut << "         default: break;\n      }\n   }\n";
+   }
+
+   rOut << "}\n\n"
+           "void " << rPrefix << "initFsm( void )\n{\n"
+           "   int i;\n"
+           "   struct " << rPrefix << "FSM_T fsm;\n"
+           "   FSM_INIT_FSM( fsm, " << stateName( rPrefix, 0 ) << ", label='Start' );\n"
+           "   for( i = 0; i < 100; i++ )\n   {\n"
+           "      " << rPrefix << "executeFsm( &fsm );\n   }\n}\n";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void FsmGenerator::writeFunctionPointer( std::ostream& rOut,
+                                         const std::string& rPrefix )
+{
+   rOut << "#define FSM_DECLARE_STATE( state, attr... ) void state ( void** ppState )\n"
+           "#define FSM_TRANSITION( newState, attr... ) *ppState = newState\n"
+           "#define FSM_INIT_FSM( startState, attr... ) currentState = startState\n\n"
+           "typedef void (*" << rPrefix << "STATE_F)( void** );\n\n";
+
+   for( unsigned int i = 0; i < m_states; i++ )
+   {
+      rOut << "FSM_DECLARE_STATE( " << stateName( rPrefix, i );
+      writeAttributes( rOut, true, i );
+      rOut << " );\n";
+   }
+
+   for( unsigned int i = 0; i < m_states; i++ )
+   {
+      rOut << "\nvoid " << stateName( rPrefix, i ) << "( void** ppState )\n{\n"
+              "   static int counter;\n"
+              "   counter++;\n"
+              "   do\n   {\n";
+      writeTransitions( rOut, rPrefix, i, 2, "counter" );
+      rOut << "   }\n   while( 0 );\n}\n";
+   }
+
+   rOut << "\nvoid " << rPrefix << "runFsm( void )\n{\n"
+           "   int i;\n"
+           "   " << rPrefix << "STATE_F currentState;\n"
+           "   FSM_INIT_FSM( " << stateName( rPrefix, 0 ) << ", label='Start' );\n"
+           "   for( i = 0; i < 100; i++ )\n   {\n"
+           "      currentState( (void**)&currentState );\n   }\n}\n";
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Each transition becomes surrounded by the given number of
+ *        nested blocks. The surrounding code has to provide the variable
+ *        pCounter and a enclosing loop or switch for "break".
+ */
+void FsmGenerator::writeTransitions( std::ostream& rOut,
+                                     const std::string& rPrefix,
+                                     unsigned int state, int tabs,
+                                     const char* pCounter )
+{
+   for( unsigned int t = 0; t < m_transitions; t++ )
+   {
+      for( unsigned int n = 0; n < m_nesting; n++ )
+      {
+         indent( rOut, tabs + n );
+         rOut << "if( " << pCounter << " > " << n << " )\n";
+         indent( rOut, tabs + n );
+         rOut << "{\n";
+      }
+      const int inner = tabs + m_nesting;
+      indent( rOut, inner );
+      rOut << "if( " << pCounter << " == " << t << " )\n";
+      indent( rOut, inner );
+      rOut << "{\n";
+      indent( rOut, inner + 1 );
+      rOut << "FSM_TRANSITION( " << stateName( rPrefix, getTarget( state ) );
+      writeAttributes( rOut, false, t );
+      rOut << " );\n";
+      indent( rOut, inner + 1 );
+      rOut << "break;\n";
+      indent( rOut, inner );
+      rOut << "}\n";
+      for( int n = m_nesting - 1; n >= 0; n-- )
+      {
+         indent( rOut, tabs + n );
+         rOut << "}\n";
+      }
+   }
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void FsmGenerator::writeAttributes( std::ostream& rOut, bool forState,
+                                    unsigned int number )
+{
+   if( forState )
+      rOut << ", label='State " << number << "'";
+   else
+      rOut << ", label='event " << number << "'";
+
+   const char* const* pAttributes = forState? c_stateAttributes : c_transitionAttributes;
+   const unsigned int size = forState? ARRAY_SIZE( c_stateAttributes ) :
+                                       ARRAY_SIZE( c_transitionAttributes );
+   for( unsigned int i = 0; (i < m_attributes) && (i < size); i++ )
+      rOut << ", " << pAttributes[i];
+}
+
+/*!----------------------------------------------------------------------------
+*/
+unsigned int FsmGenerator::getTarget( unsigned int state )
+{
+   if( m_states == 1 )
+      return state;
+   /*
+    * Never the state itself, so each transition becomes visible.
+    */
+   return (state + 1 + m_random() % (m_states - 1)) % m_states;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+std::string FsmGenerator::stateName( const std::string& rPrefix, unsigned int state )
+{
+   return rPrefix + "S" + std::to_string( state );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void FsmGenerator::indent( std::ostream& rOut, int tabs )
+{
+   for( int i = 0; i < tabs; i++ )
+      rOut << "   ";
+}
+
+//================================== EOF ======================================
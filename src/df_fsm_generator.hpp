@@ -0,0 +1,161 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!    @brief Module generates synthetic C-sources containing FSMs for       */
+/*!           benchmarking DocFsm.                                           */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_fsm_generator.hpp                                            */
+/*! @see     df_fsm_generator.cpp                                            */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#ifndef _DF_FSM_GENERATOR_HPP
+#define _DF_FSM_GENERATOR_HPP
+
+#ifndef __DOCFSM__
+ #include <string>
+ #include <vector>
+ #include <ostream>
+ #include <random>
+ #include "df_commandline.hpp"
+#endif
+
+namespace DocFsm
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Writes C-source files with FSMs in the styles of the examples
+ *        in "examples/general".
+ *
+ * - SWITCH_CASE:      States as enum, transitions within a switch-case.
+ * - FUNCTION_POINTER: Each state is a do-function.
+ * - ENTRY_EXIT:       Like SWITCH_CASE with additional entry- and exit
+ *                     switch-cases.
+ *
+ * The generated code is deterministic for the same parameters.
+ */
+class FsmGenerator
+{
+public:
+   using FILE_NAME_LIST_T = std::vector<std::string>;
+
+   enum STYLE_T
+   {
+      SWITCH_CASE,
+      FUNCTION_POINTER,
+      ENTRY_EXIT,
+      MIXED
+   };
+
+private:
+   class Option: public CLOP::OPTION_V
+   {
+   protected:
+      FsmGenerator*  m_pParent;
+      Option( FsmGenerator* pParent )
+         :m_pParent( pParent )
+      {
+         m_hasArg   = REQUIRED_ARG;
+         m_shortOpt = '\0';
+      }
+      static bool getNumber( CLOP::PARSER* poParser, unsigned int& rNumber );
+   };
+
+   class OptionFiles: public Option
+   {
+   public:
+      OptionFiles( FsmGenerator* );
+      int onGiven( CLOP::PARSER* poParser ) override;
+   };
+
+   class OptionStates: public Option
+   {
+   public:
+      OptionStates( FsmGenerator* );
+      int onGiven( CLOP::PARSER* poParser ) override;
+   };
+
+   class OptionTransitions: public Option
+   {
+   public:
+      OptionTransitions( FsmGenerator* );
+      int onGiven( CLOP::PARSER* poParser ) override;
+   };
+
+   class OptionAttributes: public Option
+   {
+   public:
+      OptionAttributes( FsmGenerator* );
+      int onGiven( CLOP::PARSER* poParser ) override;
+   };
+
+   class OptionNesting: public Option
+   {
+   public:
+      OptionNesting( FsmGenerator* );
+      int onGiven( CLOP::PARSER* poParser ) override;
+   };
+
+   class OptionStyle: public Option
+   {
+   public:
+      OptionStyle( FsmGenerator* );
+      int onGiven( CLOP::PARSER* poParser ) override;
+   };
+
+   class OptionDirectory: public Option
+   {
+   public:
+      OptionDirectory( FsmGenerator* );
+      int onGiven( CLOP::PARSER* poParser ) override;
+   };
+
+   OptionFiles          m_oOptionFiles;
+   OptionStates         m_oOptionStates;
+   OptionTransitions    m_oOptionTransitions;
+   OptionAttributes     m_oOptionAttributes;
+   OptionNesting        m_oOptionNesting;
+   OptionStyle          m_oOptionStyle;
+   OptionDirectory      m_oOptionDirectory;
+   unsigned int         m_files;
+   unsigned int         m_states;
+   unsigned int         m_transitions;
+   unsigned int         m_attributes;
+   unsigned int         m_nesting;
+   STYLE_T              m_style;
+   std::string          m_directory;
+   std::minstd_rand     m_random;
+
+public:
+   FsmGenerator( CommandlineParser& rParser );
+
+   /*!
+    * @brief Directory given by option, empty if not given.
+    */
+   const std::string& getDirectory( void ) const { return m_directory; }
+
+   /*!
+    * @brief Writes the files into the given directory and appends
+    *        their names to the given list.
+    * @retval true Error
+    */
+   bool generate( const std::string& rDirectory, FILE_NAME_LIST_T& rFiles );
+
+private:
+   void generateFile( std::ostream& rOut, unsigned int fileNumber, STYLE_T style );
+   void writeSwitchCase( std::ostream& rOut, const std::string& rPrefix,
+                         bool withEntryExit );
+   void writeFunctionPointer( std::ostream& rOut, const std::string& rPrefix );
+   void writeTransitions( std::ostream& rOut, const std::string& rPrefix,
+                          unsigned int state, int tabs, const char* pCounter );
+   void writeAttributes( std::ostream& rOut, bool forState, unsigned int number );
+   unsigned int getTarget( unsigned int state );
+   static std::string stateName( const std::string& rPrefix, unsigned int state );
+   static void indent( std::ostream& rOut, int tabs );
+};
+
+} // End namespace DocFsm
+#endif // ifndef _DF_FSM_GENERATOR_HPP
+//================================== EOF ======================================
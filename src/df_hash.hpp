@@ -0,0 +1,58 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!       @brief Hash function for the keys of the cache-entries             */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_hash.hpp                                                     */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#ifndef _DF_HASH_HPP
+#define _DF_HASH_HPP
+
+#ifndef __DOCFSM__
+ #include <stdint.h>
+ #include <string>
+#endif
+
+namespace DocFsm
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief 64 bit FNV-1a hash.
+ */
+class Hash
+{
+   uint64_t  m_value;
+public:
+   Hash( void ): m_value( 0xCBF29CE484222325ULL ) {}
+
+   void add( const void* pData, std::size_t size )
+   {
+      const uint8_t* p = static_cast<const uint8_t*>( pData );
+      for( std::size_t i = 0; i < size; i++ )
+      {
+         m_value ^= p[i];
+         m_value *= 0x100000001B3ULL;
+      }
+   }
+
+   void add( const std::string& rStr )
+   {
+      add( rStr.size() );
+      add( rStr.data(), rStr.size() );
+   }
+
+   void add( uint64_t value )
+   {
+      add( &value, sizeof( value ) );
+   }
+
+   uint64_t operator()( void ) const { return m_value; }
+};
+
+} // End namespace DocFsm
+#endif // ifndef _DF_HASH_HPP
+//================================== EOF ======================================
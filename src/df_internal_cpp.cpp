@@ -0,0 +1,1023 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!    @brief Module implements a lightweight built-in preprocessor as       */
+/*!           alternative to the external "cpp".                             */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_internal_cpp.cpp                                             */
+/*! @see     df_internal_cpp.hpp                                             */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#ifndef __DOCFSM__
+ #include <fstream>
+ #include <stdlib.h>
+ #include <limits.h>
+ #include <sys/stat.h>
+#endif
+#include "messages.hpp"
+#include "df_keyword.hpp"
+#include "df_internal_cpp.hpp"
+
+using namespace DocFsm;
+
+#define CPP_ERROR( file, line, args... )                                   \
+   m_rErr << RED BOLD "ERROR: " << file << ':' << line << ": "             \
+          << args << NORMAL << std::endl
+
+#define CPP_WARNING( file, line, args... )                                 \
+   m_rErr << YELLOW BOLD "WARNING: " << file << ':' << line << ": "        \
+          << args << NORMAL << std::endl
+
+/*!
+ * @brief Maximum nesting depth of include-files, the same like cpp.
+ */
+#define MAX_INCLUDE_DEPTH 200
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Evaluates the expression of "#if" and "#elif".
+ */
+class InternalCpp::Expression
+{
+   using TOKEN_LIST_T = std::vector<std::string>;
+
+   const MACRO_MAP_T&     m_rMacros;
+   std::set<std::string>  m_expanding;
+   TOKEN_LIST_T           m_vTokens;
+   std::size_t            m_pos;
+   std::string            m_error;
+
+public:
+   Expression( const MACRO_MAP_T& rMacros )
+      :m_rMacros( rMacros )
+      ,m_pos( 0 )
+   {}
+
+   bool evaluate( const std::string& rExpression, long long& rResult );
+
+   const std::string& getError( void ) const { return m_error; }
+
+private:
+   static void tokenize( const std::string& rStr, TOKEN_LIST_T& rTokens );
+   void expand( const TOKEN_LIST_T& rIn, TOKEN_LIST_T& rOut );
+   bool isNext( const char* str ) const
+   {
+      return (m_pos < m_vTokens.size()) && (m_vTokens[m_pos] == str);
+   }
+   bool setError( const std::string& rError )
+   {
+      if( m_error.empty() )
+         m_error = rError;
+      return true;
+   }
+   /*
+    * The parameter "evaluated" is false for the operands which become
+    * skipped by "&&", "||" and "?:", like in C errors of their values,
+    * e.g. a division by zero, are not reported.
+    */
+   long long conditional( bool evaluated );
+   long long binary( int level, bool evaluated );
+   long long unary( bool evaluated );
+   long long primary( bool evaluated );
+   static long long shift( long long value, long long count, bool left );
+};
+
+/*!----------------------------------------------------------------------------
+*/
+void InternalCpp::Expression::tokenize( const std::string& rStr,
+                                        TOKEN_LIST_T& rTokens )
+{
+   static const char* c_twoCharOperators[] =
+   {
+      "&&", "||", "==", "!=", "<=", ">=", "<<", ">>"
+   };
+
+   std::size_t i = 0;
+   while( i < rStr.size() )
+   {
+      const char c = rStr[i];
+      if( Keyword::isFillChar( c ) )
+      {
+         i++;
+         continue;
+      }
+      std::size_t begin = i++;
+      if( Keyword::isKeywordChar( c ) )
+      {
+         while( (i < rStr.size()) &&
+                (Keyword::isKeywordChar( rStr[i] ) || (rStr[i] == '.')) )
+            i++;
+      }
+      else if( c == '\'' )
+      {
+         while( (i < rStr.size()) && (rStr[i] != '\'') )
+         {
+            if( rStr[i] == '\\' )
+               i++;
+            i++;
+         }
+         i++;
+      }
+      else
+      {
+         for( const auto& op : c_twoCharOperators )
+         {
+            if( rStr.compare( begin, 2, op ) == 0 )
+            {
+               i++;
+               break;
+            }
+         }
+      }
+      rTokens.push_back( rStr.substr( begin, i - begin ) );
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ * Resolves "defined", expands object-like macros recursively and replaces
+ * all remaining identifiers by zero.
+ */
+void InternalCpp::Expression::expand( const TOKEN_LIST_T& rIn,
+                                      TOKEN_LIST_T& rOut )
+{
+   for( std::size_t i = 0; i < rIn.size(); i++ )
+   {
+      const std::string& rToken = rIn[i];
+      if( !Keyword::isKeywordChar( rToken[0] ) ||
+          ((rToken[0] >= '0') && (rToken[0] <= '9')) )
+      {
+         rOut.push_back( rToken );
+         continue;
+      }
+
+      if( rToken == "defined" )
+      {
+         bool braced = ((i + 1) < rIn.size()) && (rIn[i + 1] == "(");
+         if( braced )
+            i++;
+         if( ++i >= rIn.size() )
+         {
+            setError( "Missing macro name after \"defined\"" );
+            return;
+         }
+         rOut.push_back( (m_rMacros.count( rIn[i] ) != 0)? "1" : "0" );
+         if( braced && ((++i >= rIn.size()) || (rIn[i] != ")")) )
+         {
+            setError( "Missing \')\' after \"defined\"" );
+            return;
+         }
+         continue;
+      }
+
+      const auto it = m_rMacros.find( rToken );
+      if( (it == m_rMacros.end()) || (m_expanding.count( rToken ) != 0) )
+      {
+         rOut.push_back( (rToken == "true")? "1" : "0" );
+         continue;
+      }
+
+      if( it->second.m_isFunction )
+      {
+         if( ((i + 1) < rIn.size()) && (rIn[i + 1] == "(") )
+         {
+            int level = 0;
+            do
+            {
+               i++;
+               if( rIn[i] == "(" )
+                  level++;
+               else if( rIn[i] == ")" )
+                  level--;
+            }
+            while( (level > 0) && ((i + 1) < rIn.size()) );
+         }
+         rOut.push_back( "0" );
+         continue;
+      }
+
+      TOKEN_LIST_T body;
+      tokenize( it->second.m_body, body );
+      m_expanding.insert( rToken );
+      expand( body, rOut );
+      m_expanding.erase( rToken );
+   }
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool InternalCpp::Expression::evaluate( const std::string& rExpression,
+                                        long long& rResult )
+{
+   TOKEN_LIST_T tokens;
+   tokenize( rExpression, tokens );
+   m_vTokens.clear();
+   expand( tokens, m_vTokens );
+   if( !m_error.empty() )
+      return true;
+
+   if( m_vTokens.empty() )
+      return setError( "#if with no expression" );
+
+   m_pos = 0;
+   rResult = conditional( true );
+   if( m_error.empty() && (m_pos < m_vTokens.size()) )
+      setError( "Missing binary operator before token \"" +
+                 m_vTokens[m_pos] + "\"" );
+   return !m_error.empty();
+}
+
+/*!----------------------------------------------------------------------------
+*/
+long long InternalCpp::Expression::conditional( bool evaluated )
+{
+   long long condition = binary( 0, evaluated );
+   if( !isNext( "?" ) )
+      return condition;
+   m_pos++;
+   long long first = conditional( evaluated && (condition != 0) );
+   if( !isNext( ":" ) )
+   {
+      setError( "Missing \':\' in conditional expression" );
+      return 0;
+   }
+   m_pos++;
+   long long second = conditional( evaluated && (condition == 0) );
+   return (condition != 0)? first : second;
+}
+
+/*!----------------------------------------------------------------------------
+ * Binary operators sorted by ascending precedence.
+ */
+long long InternalCpp::Expression::binary( int level, bool evaluated )
+{
+   static const std::vector<TOKEN_LIST_T> c_levels =
+   {
+      { "||" }, { "&&" }, { "|" }, { "^" }, { "&" },
+      { "==", "!=" }, { "<", ">", "<=", ">=" }, { "<<", ">>" },
+      { "+", "-" }, { "*", "/", "%" }
+   };
+
+   if( level >= static_cast<int>(c_levels.size()) )
+      return unary( evaluated );
+
+   long long left = binary( level + 1, evaluated );
+   while( m_pos < m_vTokens.size() )
+   {
+      const std::string& rOp = m_vTokens[m_pos];
+      bool found = false;
+      for( const auto& op : c_levels[level] )
+      {
+         if( op == rOp )
+         {
+            found = true;
+            break;
+         }
+      }
+      if( !found )
+         break;
+
+      m_pos++;
+      bool evaluateRight = evaluated;
+      if( rOp == "||" )
+         evaluateRight = evaluated && (left == 0);
+      else if( rOp == "&&" )
+         evaluateRight = evaluated && (left != 0);
+      long long right = binary( level + 1, evaluateRight );
+      if( rOp == "||" )      left = (left != 0) || (right != 0);
+      else if( rOp == "&&" ) left = (left != 0) && (right != 0);
+      else if( rOp == "|" )  left |= right;
+      else if( rOp == "^" )  left ^= right;
+      else if( rOp == "&" )  left &= right;
+      else if( rOp == "==" ) left = (left == right);
+      else if( rOp == "!=" ) left = (left != right);
+      else if( rOp == "<" )  left = (left < right);
+      else if( rOp == ">" )  left = (left > right);
+      else if( rOp == "<=" ) left = (left <= right);
+      else if( rOp == ">=" ) left = (left >= right);
+      else if( rOp == "<<" ) left = shift( left, right, true );
+      else if( rOp == ">>" ) left = shift( left, right, false );
+      /*
+       * Calculated unsigned, so an overflow wraps around instead of
+       * being undefined.
+       */
+      else if( rOp == "+" )
+         left = static_cast<long long>(static_cast<unsigned long long>(left) +
+                                       static_cast<unsigned long long>(right));
+      else if( rOp == "-" )
+         left = static_cast<long long>(static_cast<unsigned long long>(left) -
+                                       static_cast<unsigned long long>(right));
+      else if( rOp == "*" )
+         left = static_cast<long long>(static_cast<unsigned long long>(left) *
+                                       static_cast<unsigned long long>(right));
+      else if( right == 0 )
+      {
+         if( evaluated )
+         {
+            setError( "Division by zero in #if" );
+            return 0;
+         }
+         left = 0;
+      }
+      else if( (right == -1) && (left == LLONG_MIN) )
+      { /*
+         * The only quotient which doesn't fit in long long.
+         */
+         left = (rOp == "/")? LLONG_MIN : 0;
+      }
+      else if( rOp == "/" )
+         left /= right;
+      else
+         left %= right;
+   }
+   return left;
+}
+
+/*!----------------------------------------------------------------------------
+ * Like cpp a negative count shifts in the opposite direction. A count
+ * beyond the width delivers 0, respectively the sign for a right shift
+ * of a negative value.
+ */
+long long InternalCpp::Expression::shift( long long value, long long count,
+                                          bool left )
+{
+   static const long long c_bits = sizeof( long long ) * 8;
+
+   if( count < 0 )
+   {
+      if( count == LLONG_MIN )
+         count++;
+      count = -count;
+      left = !left;
+   }
+   if( left )
+   {
+      if( count >= c_bits )
+         return 0;
+      return static_cast<long long>(static_cast<unsigned long long>(value) << count);
+   }
+   if( count >= c_bits )
+      return (value < 0)? -1 : 0;
+   return value >> count;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+long long InternalCpp::Expression::unary( bool evaluated )
+{
+   if( isNext( "!" ) )
+   {
+      m_pos++;
+      return unary( evaluated ) == 0;
+   }
+   if( isNext( "~" ) )
+   {
+      m_pos++;
+      return ~unary( evaluated );
+   }
+   if( isNext( "-" ) )
+   {
+      m_pos++;
+      return static_cast<long long>(0ULL - static_cast<unsigned long long>(unary( evaluated )));
+   }
+   if( isNext( "+" ) )
+   {
+      m_pos++;
+      return unary( evaluated );
+   }
+   return primary( evaluated );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+long long InternalCpp::Expression::primary( bool evaluated )
+{
+   if( m_pos >= m_vTokens.size() )
+   {
+      setError( "Unexpected end of expression in #if" );
+      return 0;
+   }
+
+   const std::string& rToken = m_vTokens[m_pos++];
+   if( rToken == "(" )
+   {
+      long long value = conditional( evaluated );
+      if( !isNext( ")" ) )
+      {
+         setError( "Missing \')\' in expression" );
+         return 0;
+      }
+      m_pos++;
+      return value;
+   }
+
+   if( rToken[0] == '\'' )
+   {
+      if( rToken.size() < 3 )
+      {
+         setError( "Empty character constant in #if" );
+         return 0;
+      }
+      if( rToken[1] != '\\' )
+         return static_cast<unsigned char>(rToken[1]);
+      switch( rToken[2] )
+      {
+         case 'n': return '\n';
+         case 't': return '\t';
+         case 'r': return '\r';
+         case '0': return '\0';
+         default: break;
+      }
+      return static_cast<unsigned char>(rToken[2]);
+   }
+
+   if( (rToken[0] >= '0') && (rToken[0] <= '9') )
+   {
+      std::string number = rToken;
+      while( !number.empty() &&
+             ((number.back() == 'u') || (number.back() == 'U') ||
+              (number.back() == 'l') || (number.back() == 'L')) )
+         number.pop_back();
+      char* pEnd;
+      long long value = static_cast<long long>(::strtoull( number.c_str(), &pEnd, 0 ));
+      if( *pEnd != '\0' )
+         setError( "Invalid integer constant \"" + rToken + "\" in #if" );
+      return value;
+   }
+
+   setError( "Token \"" + rToken + "\" is not valid in #if" );
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+InternalCpp::InternalCpp( const OPTION_LIST_T& rOptionList,
+                          std::string& rOut, std::ostream& rErr )
+   :m_rOut( rOut )
+   ,m_rErr( rErr )
+   ,m_includeDepth( 0 )
+   ,m_pvFiles( nullptr )
+{
+   define( "__STDC__ 1" );
+   define( "__linux__ 1" );
+   define( "__unix__ 1" );
+
+   for( const auto& rOption : rOptionList )
+   {
+      if( rOption.compare( 0, 2, "-I" ) == 0 )
+         m_vIncludeDirs.push_back( rOption.substr( 2 ) );
+      else if( rOption.compare( 0, 8, "-isystem" ) == 0 )
+         m_vIncludeDirs.push_back( rOption.substr( 8 ) );
+      else if( rOption.compare( 0, 7, "-iquote" ) == 0 )
+         m_vIncludeDirs.push_back( rOption.substr( 7 ) );
+      else if( rOption.compare( 0, 2, "-D" ) == 0 )
+         defineCommandline( rOption.substr( 2 ) );
+      else if( rOption.compare( 0, 2, "-U" ) == 0 )
+         m_macros.erase( rOption.substr( 2 ) );
+      else if( rOption.compare( 0, 5, "-std=" ) == 0 )
+      {
+         const std::string std = rOption.substr( 5 );
+         const std::size_t i = std.find( "++" );
+         if( i == std::string::npos )
+            continue;
+         static const std::unordered_map<std::string, const char*> c_versions =
+         {
+            { "98", "199711L" }, { "03", "199711L" },
+            { "11", "201103L" }, { "0x", "201103L" },
+            { "14", "201402L" }, { "1y", "201402L" },
+            { "17", "201703L" }, { "1z", "201703L" },
+            { "20", "202002L" }, { "2a", "202002L" }
+         };
+         const auto it = c_versions.find( std.substr( i + 2 ) );
+         if( it != c_versions.end() )
+            define( std::string( "__cplusplus " ) + it->second );
+      }
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ * Expects the definition in the form of the directive "#define", i.e.
+ * "NAME BODY" or "NAME(ARGS) BODY".
+ */
+void InternalCpp::define( const std::string& rDefinition )
+{
+   std::size_t i = 0;
+   while( (i < rDefinition.size()) && Keyword::isKeywordChar( rDefinition[i] ) )
+      i++;
+   if( i == 0 )
+      return;
+
+   MACRO_T& rMacro = m_macros[rDefinition.substr( 0, i )];
+   rMacro.m_isFunction = (i < rDefinition.size()) && (rDefinition[i] == '(');
+   if( rMacro.m_isFunction )
+   {
+      i = rDefinition.find( ')', i );
+      if( i == std::string::npos )
+         i = rDefinition.size();
+      else
+         i++;
+   }
+   while( (i < rDefinition.size()) && Keyword::isFillChar( rDefinition[i] ) )
+      i++;
+   rMacro.m_body = rDefinition.substr( i );
+}
+
+/*!----------------------------------------------------------------------------
+ * Like cpp the option "-D NAME" defines NAME with the value 1 and
+ * "-D NAME=VALUE" with VALUE.
+ */
+void InternalCpp::defineCommandline( const std::string& rArg )
+{
+   const std::size_t i = rArg.find( '=' );
+   if( i == std::string::npos )
+   {
+      define( rArg + " 1" );
+      return;
+   }
+   std::string definition = rArg;
+   definition[i] = ' ';
+   define( definition );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+std::string InternalCpp::directoryOf( const std::string& rFilename )
+{
+   const std::size_t i = rFilename.rfind( '/' );
+   if( i == std::string::npos )
+      return std::string();
+   return rFilename.substr( 0, i + 1 );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool InternalCpp::isCppFile( const std::string& rFilename )
+{
+   static const char* c_extensions[] =
+   {
+      ".cpp", ".cc", ".cxx", ".c++", ".C", ".hpp", ".hh", ".hxx", ".H"
+   };
+   const std::size_t i = rFilename.rfind( '.' );
+   if( i == std::string::npos )
+      return false;
+   for( const auto& ext : c_extensions )
+   {
+      if( rFilename.compare( i, std::string::npos, ext ) == 0 )
+         return true;
+   }
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool InternalCpp::run( const std::string& rFilename )
+{
+   if( isCppFile( rFilename ) && (m_macros.count( "__cplusplus" ) == 0) )
+      define( "__cplusplus 201703L" );
+
+   m_vConditions.clear();
+   m_onceFiles.clear();
+   m_includeDepth = 0;
+   return processFile( rFilename );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool InternalCpp::run( const std::string& rFilename, const std::string& rSource )
+{
+   if( isCppFile( rFilename ) && (m_macros.count( "__cplusplus" ) == 0) )
+      define( "__cplusplus 201703L" );
+
+   m_vConditions.clear();
+   m_onceFiles.clear();
+   m_includeDepth = 0;
+   return processSource( rFilename, rSource );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool InternalCpp::readFile( const std::string& rFilename, std::string& rContent )
+{
+   std::ifstream file( rFilename, std::ios::binary );
+   if( !file.is_open() )
+      return true;
+
+   file.seekg( 0, std::ios::end );
+   const std::streamoff size = file.tellg();
+   if( size < 0 )
+      return true;
+   file.seekg( 0, std::ios::beg );
+
+   rContent.resize( static_cast<std::size_t>(size) );
+   if( size > 0 )
+      file.read( &rContent[0], size );
+   return file.fail();
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool InternalCpp::processFile( const std::string& rFilename )
+{
+   std::string source;
+   if( readFile( rFilename, source ) )
+   {
+      m_rErr << RED BOLD "ERROR: Can't read file \"" << rFilename << "\"!"
+             NORMAL << std::endl;
+      return true;
+   }
+   if( m_pvFiles != nullptr )
+      m_pvFiles->push_back( rFilename );
+
+   return processSource( rFilename, source );
+}
+
+/*!----------------------------------------------------------------------------
+ * The source-code lines of active conditional blocks will copied unchanged
+ * into the output, the directives will removed. Comments and quoted
+ * strings are respected, so that a '#' within them will not taken as
+ * directive.
+ */
+bool InternalCpp::processSource( const std::string& rFilename,
+                                 const std::string& rSource )
+{
+   const std::size_t conditionLevel = m_vConditions.size();
+   bool inBlockComment = false;
+   std::size_t lineNumber = 0;
+   std::size_t pos = 0;
+   while( pos < rSource.size() )
+   {
+      std::size_t end = rSource.find( '\n', pos );
+      if( end == std::string::npos )
+         end = rSource.size();
+      lineNumber++;
+
+      std::size_t i = pos;
+      if( !inBlockComment )
+      {
+         while( (i < end) && Keyword::isFillChar( rSource[i] ) )
+            i++;
+      }
+
+      if( !inBlockComment && (i < end) && (rSource[i] == '#') )
+      { /*
+         * Directive: joins continuation lines and removes comments.
+         */
+         std::string directive;
+         const std::size_t directiveLine = lineNumber;
+         bool inComment = false;
+         i++;
+         while( i < rSource.size() )
+         {
+            const char c = rSource[i];
+            if( inComment )
+            {
+               if( (c == '*') && ((i + 1) < rSource.size()) && (rSource[i + 1] == '/') )
+               {
+                  inComment = false;
+                  directive += ' ';
+                  i++;
+               }
+               else if( c == '\n' )
+                  lineNumber++;
+               i++;
+               continue;
+            }
+            if( c == '\n' )
+               break;
+            if( (c == '\\') && ((i + 1) < rSource.size()) && (rSource[i + 1] == '\n') )
+            {
+               lineNumber++;
+               i += 2;
+               continue;
+            }
+            if( (c == '/') && ((i + 1) < rSource.size()) )
+            {
+               if( rSource[i + 1] == '*' )
+               {
+                  inComment = true;
+                  i += 2;
+                  continue;
+               }
+               if( rSource[i + 1] == '/' )
+               {
+                  while( (i < rSource.size()) && (rSource[i] != '\n') )
+                     i++;
+                  break;
+               }
+            }
+            directive += c;
+            i++;
+         }
+         if( processDirective( directive, rFilename, directiveLine ) )
+            return true;
+         pos = i + 1;
+         continue;
+      }
+
+      /*
+       * Normal rSource-code line: tracking of comments.
+       */
+      char quote = '\0';
+      for( ; i < end; i++ )
+      {
+         const char c = rSource[i];
+         if( inBlockComment )
+         {
+            if( (c == '*') && ((i + 1) < end) && (rSource[i + 1] == '/') )
+            {
+               inBlockComment = false;
+               i++;
+            }
+            continue;
+         }
+         if( quote != '\0' )
+         {
+            if( c == '\\' )
+               i++;
+            else if( c == quote )
+               quote = '\0';
+            continue;
+         }
+         if( (c == '"') || (c == '\'') )
+         {
+            quote = c;
+            continue;
+         }
+         if( (c == '/') && ((i + 1) < end) )
+         {
+            if( rSource[i + 1] == '/' )
+               break;
+            if( rSource[i + 1] == '*' )
+            {
+               inBlockComment = true;
+               i++;
+            }
+         }
+      }
+
+      if( isActive() )
+      {
+         m_rOut.append( rSource, pos, end - pos );
+         m_rOut += '\n';
+      }
+      pos = end + 1;
+   }
+
+   if( m_vConditions.size() > conditionLevel )
+   {
+      CPP_ERROR( rFilename, lineNumber, "Unterminated conditional directive" );
+      return true;
+   }
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool InternalCpp::processDirective( const std::string& rLine,
+                                    const std::string& rFilename,
+                                    std::size_t lineNumber )
+{
+   std::size_t i = 0;
+   while( (i < rLine.size()) && Keyword::isFillChar( rLine[i] ) )
+      i++;
+   std::size_t begin = i;
+   while( (i < rLine.size()) && Keyword::isKeywordChar( rLine[i] ) )
+      i++;
+   const std::string name = rLine.substr( begin, i - begin );
+   while( (i < rLine.size()) && Keyword::isFillChar( rLine[i] ) )
+      i++;
+   std::string arg = rLine.substr( i );
+   while( !arg.empty() && Keyword::isFillChar( arg.back() ) )
+      arg.pop_back();
+
+   if( (name == "if") || (name == "ifdef") || (name == "ifndef") )
+   {
+      CONDITION_T condition;
+      condition.m_parentActive = isActive();
+      condition.m_active = false;
+      condition.m_elseSeen = false;
+      if( condition.m_parentActive )
+      {
+         if( name == "if" )
+         {
+            if( evaluate( arg, rFilename, lineNumber, condition.m_active ) )
+               return true;
+         }
+         else
+         {
+            condition.m_active = (m_macros.count( arg ) != 0) == (name == "ifdef");
+         }
+      }
+      condition.m_done = condition.m_active;
+      m_vConditions.push_back( condition );
+      return false;
+   }
+
+   if( (name == "elif") || (name == "elifdef") || (name == "elifndef") ||
+       (name == "else") )
+   {
+      if( m_vConditions.empty() )
+      {
+         CPP_ERROR( rFilename, lineNumber, "#" << name << " without #if" );
+         return true;
+      }
+      CONDITION_T& rCondition = m_vConditions.back();
+      if( rCondition.m_elseSeen )
+      {
+         CPP_ERROR( rFilename, lineNumber, "#" << name << " after #else" );
+         return true;
+      }
+      if( name == "else" )
+      {
+         rCondition.m_elseSeen = true;
+         rCondition.m_active = rCondition.m_parentActive && !rCondition.m_done;
+         rCondition.m_done = true;
+         return false;
+      }
+      if( !rCondition.m_parentActive || rCondition.m_done )
+      {
+         rCondition.m_active = false;
+         return false;
+      }
+      if( name == "elif" )
+      {
+         if( evaluate( arg, rFilename, lineNumber, rCondition.m_active ) )
+            return true;
+      }
+      else
+      {
+         rCondition.m_active = (m_macros.count( arg ) != 0) == (name == "elifdef");
+      }
+      rCondition.m_done = rCondition.m_active;
+      return false;
+   }
+
+   if( name == "endif" )
+   {
+      if( m_vConditions.empty() )
+      {
+         CPP_ERROR( rFilename, lineNumber, "#endif without #if" );
+         return true;
+      }
+      m_vConditions.pop_back();
+      return false;
+   }
+
+   if( !isActive() )
+      return false;
+
+   if( name == "define" )
+   {
+      define( arg );
+      return false;
+   }
+
+   if( name == "undef" )
+   {
+      m_macros.erase( arg );
+      return false;
+   }
+
+   if( name == "include" )
+      return include( arg, rFilename, lineNumber );
+
+   if( name == "error" )
+   {
+      CPP_ERROR( rFilename, lineNumber, "#error " << arg );
+      return true;
+   }
+
+   if( name == "warning" )
+   {
+      CPP_WARNING( rFilename, lineNumber, "#warning " << arg );
+      return false;
+   }
+
+   if( (name == "pragma") && (arg == "once") )
+   {
+      char path[PATH_MAX];
+      if( ::realpath( rFilename.c_str(), path ) != nullptr )
+         m_onceFiles.insert( path );
+      return false;
+   }
+
+   /*
+    * All other directives like "#line" or "#pragma" have no relevance
+    * for DocFsm.
+    */
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool InternalCpp::include( const std::string& rArg, const std::string& rFilename,
+                           std::size_t lineNumber )
+{
+   std::string arg = rArg;
+   if( !arg.empty() && Keyword::isKeywordChar( arg[0] ) )
+   { // Computed include by a object-like macro.
+      const auto it = m_macros.find( arg );
+      if( (it != m_macros.end()) && !it->second.m_isFunction )
+         arg = it->second.m_body;
+   }
+
+   if( arg.size() < 2 || ((arg[0] != '"') && (arg[0] != '<')) )
+   {
+      CPP_ERROR( rFilename, lineNumber, "#include expects \"FILENAME\" or <FILENAME>" );
+      return true;
+   }
+
+   const bool isQuoted = (arg[0] == '"');
+   const std::size_t end = arg.find( isQuoted? '"' : '>', 1 );
+   if( end == std::string::npos )
+   {
+      CPP_ERROR( rFilename, lineNumber, "Missing terminating character in #include" );
+      return true;
+   }
+   const std::string name = arg.substr( 1, end - 1 );
+
+   std::string path;
+   if( !findIncludeFile( name, isQuoted, rFilename, path ) )
+   {
+      if( !isQuoted )
+         return false; // System-header, not relevant for DocFsm.
+      CPP_ERROR( rFilename, lineNumber, name << ": No such file or directory" );
+      return true;
+   }
+
+   char realPath[PATH_MAX];
+   if( (::realpath( path.c_str(), realPath ) != nullptr) &&
+       (m_onceFiles.count( realPath ) != 0) )
+      return false;
+
+   if( m_includeDepth >= MAX_INCLUDE_DEPTH )
+   {
+      CPP_ERROR( rFilename, lineNumber, "#include nested depth "
+                 << m_includeDepth << " exceeds maximum of " << MAX_INCLUDE_DEPTH );
+      return true;
+   }
+
+   m_includeDepth++;
+   bool ret = processFile( path );
+   m_includeDepth--;
+   return ret;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool InternalCpp::findIncludeFile( const std::string& rName, bool isQuoted,
+                                   const std::string& rFilename,
+                                   std::string& rPath )
+{
+   auto isFile = []( const std::string& rPath ) -> bool
+   {
+      struct stat status;
+      return (::stat( rPath.c_str(), &status ) == 0) && S_ISREG( status.st_mode );
+   };
+
+   if( !rName.empty() && (rName[0] == '/') )
+   {
+      rPath = rName;
+      return isFile( rPath );
+   }
+
+   if( isQuoted )
+   {
+      rPath = directoryOf( rFilename ) + rName;
+      if( isFile( rPath ) )
+         return true;
+   }
+
+   for( const auto& rDir : m_vIncludeDirs )
+   {
+      rPath = rDir;
+      if( !rPath.empty() && (rPath.back() != '/') )
+         rPath += '/';
+      rPath += rName;
+      if( isFile( rPath ) )
+         return true;
+   }
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool InternalCpp::evaluate( const std::string& rExpression,
+                            const std::string& rFilename,
+                            std::size_t lineNumber, bool& rResult )
+{
+   Expression expression( m_macros );
+   long long value = 0;
+   if( expression.evaluate( rExpression, value ) )
+   {
+      CPP_ERROR( rFilename, lineNumber, expression.getError() );
+      return true;
+   }
+   rResult = (value != 0);
+   return false;
+}
+
+//================================== EOF ======================================
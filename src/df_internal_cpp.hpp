@@ -0,0 +1,127 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!    @brief Module implements a lightweight built-in preprocessor as       */
+/*!           alternative to the external "cpp".                             */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_internal_cpp.hpp                                             */
+/*! @see     df_internal_cpp.cpp                                             */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#ifndef _DF_INTERNAL_CPP_HPP
+#define _DF_INTERNAL_CPP_HPP
+
+#ifndef __DOCFSM__
+ #include <string>
+ #include <vector>
+ #include <set>
+ #include <unordered_map>
+ #include <iostream>
+#endif
+
+namespace DocFsm
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Built-in preprocessor which runs without forking a process.
+ *
+ * It does the same as "cpp -P -fdirectives-only" as far as it is
+ * necessary for DocFsm:
+ * - "#include" of the directory of the including file and of the
+ *   directories given by "-I". System headers which are not found in the
+ *   "-I" directories become skipped.
+ * - "#define" and "#undef" as well as the options "-D" and "-U".
+ * - Conditionals "#if", "#ifdef", "#ifndef", "#elif", "#else" and "#endif".
+ *
+ * Like in the directives-only mode of cpp the macros in the source-code
+ * will not expanded. Within conditional expressions object-like macros will
+ * expanded, function-like macro calls become evaluated as zero.
+ */
+class InternalCpp
+{
+   using OPTION_LIST_T = std::vector<std::string>;
+
+   struct MACRO_T
+   {
+      std::string m_body;
+      bool        m_isFunction;
+   };
+
+   using MACRO_MAP_T = std::unordered_map<std::string, MACRO_T>;
+
+   /*!
+    * @brief State of a conditional block "#if ... #endif"
+    */
+   struct CONDITION_T
+   {
+      bool m_parentActive;
+      bool m_active;
+      bool m_done;
+      bool m_elseSeen;
+   };
+
+   class Expression;
+
+   std::string&               m_rOut;
+   std::ostream&              m_rErr;
+   OPTION_LIST_T              m_vIncludeDirs;
+   MACRO_MAP_T                m_macros;
+   std::set<std::string>      m_onceFiles;
+   std::vector<CONDITION_T>   m_vConditions;
+   int                        m_includeDepth;
+   OPTION_LIST_T*             m_pvFiles;
+
+public:
+   InternalCpp( const OPTION_LIST_T& rOptionList,
+                std::string& rOut, std::ostream& rErr );
+
+   bool run( const std::string& rFilename );
+   bool operator()( const std::string& rFilename )
+   {
+      return run( rFilename );
+   }
+
+   /*!
+    * @brief Preprocesses the source-code given in memory.
+    * @param rFilename Name of the source, used for the messages, for
+    *                  the line-markers and for resolving quoted includes.
+    * @param rSource   Source-code
+    */
+   bool run( const std::string& rFilename, const std::string& rSource );
+
+   /*!
+    * @brief The names of all files read by the following run, the
+    *        source-file and its included files, become appended to
+    *        the given list.
+    */
+   void setFileList( OPTION_LIST_T* pvFiles ) { m_pvFiles = pvFiles; }
+
+private:
+   void define( const std::string& rDefinition );
+   void defineCommandline( const std::string& rArg );
+   bool processFile( const std::string& rFilename );
+   bool processSource( const std::string& rFilename, const std::string& rSource );
+   static bool readFile( const std::string& rFilename, std::string& rContent );
+   bool processDirective( const std::string& rLine,
+                          const std::string& rFilename, std::size_t lineNumber );
+   bool include( const std::string& rArg, const std::string& rFilename,
+                 std::size_t lineNumber );
+   bool findIncludeFile( const std::string& rName, bool isQuoted,
+                         const std::string& rFilename, std::string& rPath );
+   bool isActive( void ) const
+   {
+      return m_vConditions.empty() || m_vConditions.back().m_active;
+   }
+   bool evaluate( const std::string& rExpression, const std::string& rFilename,
+                  std::size_t lineNumber, bool& rResult );
+
+   static std::string directoryOf( const std::string& rFilename );
+   static bool isCppFile( const std::string& rFilename );
+};
+
+} // End namespace DocFsm
+#endif // ifndef _DF_INTERNAL_CPP_HPP
+//================================== EOF ======================================
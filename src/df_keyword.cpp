@@ -16,6 +16,8 @@
  #include <assert.h>
 #endif
 
+#include "messages.hpp"
+
 #include "df_keyword.hpp"
 
 using namespace DocFsm;
@@ -24,7 +26,6 @@ using namespace DocFsm;
 /*!----------------------------------------------------------------------------
 */
 Keyword::Keyword( void )
-   : m_lastChar( '\0' )
 {
    m_oCurrentWord.clear();
 }
@@ -82,10 +83,10 @@ bool Keyword::addIfBelongsToKeyword( const char c )
 
 /*!----------------------------------------------------------------------------
 */
-void Keyword::_onChar( char c )
+void Keyword::onKeywordChars( const char* pBegin, std::size_t len )
 {
-   onChar( c );
-   m_lastChar = c;
+   for( std::size_t i = 0; i < len; i++ )
+      _onChar( pBegin[i] );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -115,17 +116,92 @@ void SourceBrowser::back( void )
 
 /*!----------------------------------------------------------------------------
 */
+bool SourceBrowser::scan( void )
+{
+   m_vTokens.clear();
+
+   if( m_rsSource.size() > UINT32_MAX )
+   {
+      ERROR_MESSAGE( "Source-code too large: " << m_rsSource.size() << " bytes" );
+      return true;
+   }
+
+   const std::size_t size = m_rsSource.size();
+   std::size_t i = 0;
+   while( i < size )
+   {
+      TOKEN_T token;
+      token.m_begin = i;
+      const char c = m_rsSource[i++];
+      if( Keyword::isKeywordChar( c ) )
+      {
+         while( (i < size) && Keyword::isKeywordChar( m_rsSource[i] ) )
+            i++;
+      }
+      else if( Keyword::isFillChar( c ) )
+      {
+         while( (i < size) && Keyword::isFillChar( m_rsSource[i] ) )
+            i++;
+      }
+      token.m_end = i;
+      m_vTokens.push_back( token );
+   }
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+ * A keyword-token becomes passed completely to the interpreter. Of a run of
+ * fill-characters only the first one becomes passed, because all following
+ * ones wouldn't have any further effect on the interpreters.
+ * If the interpreter has set a sub-interpreter, so the source-code becomes
+ * passed character by character to it, and the replaying of the
+ * token-stream continues at the character behind the sub-interpreter went
+ * back, even when this is within a token.
+ */
 bool SourceBrowser::browse( void )
 {
-   for( const auto& i : m_rsSource )
+   assert( m_stack.size() > 0 );
+   Keyword* pInterpreter = m_stack.top();
+
+   std::size_t resumePos = 0;
+   std::size_t i = 0;
+   while( i < m_vTokens.size() )
    {
-      assert( m_stack.size() > 0 );
-      assert( m_stack.size() <= 2 );
-      m_stack.top()->_onChar( i );
+      const TOKEN_T& rToken = m_vTokens[i++];
+      const std::size_t begin = std::max<std::size_t>( rToken.m_begin, resumePos );
+      const char c = m_rsSource[begin];
+
+      if( Keyword::isKeywordChar( c ) )
+      {
+         pInterpreter->onKeywordChars( &m_rsSource[begin], rToken.m_end - begin );
+         continue;
+      }
+
+      pInterpreter->_onChar( c );
+
+      if( m_stack.top() == pInterpreter )
+         continue;
+
+      resumePos = browseSubInterpreter( pInterpreter, begin + 1 );
+      while( (i < m_vTokens.size()) && (m_vTokens[i].m_end <= resumePos) )
+         i++;
    }
    return false;
 }
 
+/*!----------------------------------------------------------------------------
+*/
+std::size_t SourceBrowser::browseSubInterpreter( Keyword* pInterpreter,
+                                                 std::size_t pos )
+{
+   while( (pos < m_rsSource.size()) && (m_stack.top() != pInterpreter) )
+   {
+      assert( m_stack.size() <= 2 );
+      m_stack.top()->_onChar( m_rsSource[pos++] );
+   }
+   return pos;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /*!----------------------------------------------------------------------------
 */
@@ -144,4 +220,11 @@ void KeywordInterpreter::onChar( char c )
    addIfBelongsToKeyword( c );
 }
 
+/*!----------------------------------------------------------------------------
+*/
+void KeywordInterpreter::onKeywordChars( const char* pBegin, std::size_t len )
+{
+   appendToKeyword( pBegin, len );
+}
+
 //================================== EOF ======================================
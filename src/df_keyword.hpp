@@ -15,6 +15,8 @@
 #ifndef __DOC_FSM__
  #include <string>
  #include <stack>
+ #include <vector>
+ #include <stdint.h>
 #endif
 
 namespace DocFsm
@@ -26,14 +28,11 @@ class Keyword
 {
    friend class SourceBrowser;
    std::string m_oCurrentWord;
-   char        m_lastChar;
 
 public:
    Keyword( void );
    virtual ~Keyword( void ) {}
 
-   char getLastChar( void ) const { return m_lastChar; }
-
    virtual void onRecognized( std::string ) = 0;
    virtual void onChar( char ) = 0;
 
@@ -43,24 +42,65 @@ public:
 protected:
    bool addIfBelongsToKeyword( const char c );
 
+   /*!
+    * @brief Receives a whole sequence of keyword-characters from the
+    *        token-stream of the SourceBrowser.
+    *
+    * The default implementation invokes onChar() for each character.
+    * Derived classes which do nothing else with keyword-characters than
+    * collecting them can overwrite this by a simple append.
+    */
+   virtual void onKeywordChars( const char* pBegin, std::size_t len );
+
+   void appendToKeyword( const char* pBegin, std::size_t len )
+   {
+      m_oCurrentWord.append( pBegin, len );
+   }
+
 private:
-   void _onChar( char );
+   void _onChar( char c )
+   {
+      onChar( c );
+   }
 };
 
 ///////////////////////////////////////////////////////////////////////////////
-
+/*!
+ * @brief Browses the preparsed source-code for the keyword-interpreters.
+ *
+ * The source-code becomes split by scan() once per source-file in a compact
+ * token-stream of keywords, runs of fill-characters and single other
+ * characters. Each following browse() replays this token-stream, so the
+ * interpreters will not invoked for each single character of a keyword or
+ * of a run of fill-characters.\n
+ * Sub-interpreters like the AttributeReader which has been set during
+ * browsing will still fed character by character, till they go back.
+ */
 class SourceBrowser
 {
+   struct TOKEN_T
+   {
+      uint32_t m_begin;
+      uint32_t m_end;
+   };
+
+   using TOKEN_LIST_T = std::vector<TOKEN_T>;
+
    std::string&         m_rsSource;
    std::stack<Keyword*> m_stack;
+   TOKEN_LIST_T         m_vTokens;
 
 public:
    SourceBrowser( std::string& rsSource );
 
    void set( Keyword* pInterpreter );
    void back( void );
+   bool scan( void );
    bool browse( void );
    std::string& getSource( void ) { return m_rsSource; }
+
+private:
+   std::size_t browseSubInterpreter( Keyword* pInterpreter, std::size_t pos );
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -79,6 +119,7 @@ public:
 
 protected:
    void onChar( char ) override;
+   void onKeywordChars( const char* pBegin, std::size_t len ) override;
 };
 
 } // End namespace DocFsm
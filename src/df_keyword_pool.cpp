@@ -9,7 +9,11 @@
 /*! @date    17.12.2017                                                      */
 /*  Updates:                                                                 */
 /*****************************************************************************/
+#ifndef __DOCFSM__
+ #include <algorithm>
+#endif
 #include "df_docfsm.hpp"
+#include "df_keyword.hpp"
 #include "df_keyword_pool.hpp"
 
 using namespace DocFsm;
@@ -164,19 +168,19 @@ int KeywordPool::ListKeywords::onGiven( CLOP::PARSER* poParser )
 {
    m_pParent->setDefaultsIfEmpty();
 
-   m_pParent->listTransitionKeywords( std::cout );
-   std::cout << "\n";
-   m_pParent->listDeclareKeywords( std::cout );
-   std::cout << "\n";
-   m_pParent->listInitialKeywords( std::cout );
-   std::cout << "\n";
-   m_pParent->listCallKeywords( std::cout );
-   std::cout << "\n";
-   m_pParent->listReturnKeywords( std::cout );
-   std::cout << std::endl;
-
-   ::exit( EXIT_SUCCESS );
-   return 0;
+   std::ostream& rOut = static_cast<CommandlineParser*>(poParser)->getOut();
+   m_pParent->listTransitionKeywords( rOut );
+   rOut << "\n";
+   m_pParent->listDeclareKeywords( rOut );
+   rOut << "\n";
+   m_pParent->listInitialKeywords( rOut );
+   rOut << "\n";
+   m_pParent->listCallKeywords( rOut );
+   rOut << "\n";
+   m_pParent->listReturnKeywords( rOut );
+   rOut << std::endl;
+
+   return static_cast<CommandlineParser*>(poParser)->finish();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -190,6 +194,8 @@ KeywordPool::KeywordPool( CommandlineParser& rCommandlineParser )
    ,m_overwriteCall( this )
    ,m_overwriteReturn( this )
    ,m_oListKeywords( this )
+   ,m_minLength( 1 )
+   ,m_maxLength( 0 )
 {
    rCommandlineParser( m_overwriteTransition )
                      ( m_overwriteTransitionSelf )
@@ -241,7 +247,46 @@ bool KeywordPool::setDefaultsIfEmpty( void )
       m_vReturnKeywords.push_back( "FSM_RETURN_NEXT" );
    }
 
-   return multipleCheck();
+   if( multipleCheck() )
+      return true;
+
+   freeze();
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void KeywordPool::freeze( void )
+{
+   m_index.clear();
+   m_firstChars.reset();
+   m_minLength = std::string::npos;
+   m_maxLength = 0;
+
+   addToIndex( m_vTransitionKeywords, TRANSITION );
+   addToIndex( m_vTransitionSelfKeywords, TRANSITION_SELF );
+   addToIndex( m_vDeclareKeywords, DECLARE );
+   addToIndex( m_vInitialKeywords, INITIAL );
+   addToIndex( m_vCallKeywords, CALL );
+   addToIndex( m_vReturnKeywords, RETURN );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void KeywordPool::addToIndex( const CONTAINER_T& rvKeywords, TYPE_T type )
+{
+   for( const auto& rKeyword : rvKeywords )
+   {
+      /*
+       * An empty keyword can't match a recognized word.
+       */
+      if( rKeyword.empty() )
+         continue;
+      m_index.emplace( rKeyword, type );
+      m_firstChars.set( static_cast<unsigned char>( rKeyword[0] ) );
+      m_minLength = std::min( m_minLength, rKeyword.size() );
+      m_maxLength = std::max( m_maxLength, rKeyword.size() );
+   }
 }
 
 /*!----------------------------------------------------------------------------
@@ -280,7 +325,7 @@ bool KeywordPool::multipleCheck( void )
 
 /*!----------------------------------------------------------------------------
 */
-void KeywordPool::listKeywords( std::ostream& rOut, const CONTAINER_T& rvKeywords )
+void KeywordPool::listKeywords( std::ostream& rOut, const CONTAINER_T& rvKeywords ) const
 {
    bool notFirst = false;
    for( const auto& i : rvKeywords )
@@ -306,21 +351,40 @@ bool KeywordPool::isInList( const CONTAINER_T& rvKeywords, const std::string& rW
 
 /*!----------------------------------------------------------------------------
 */
-KeywordPool::TYPE_T KeywordPool::determineTransitionType( const std::string& rWord )
+KeywordPool::TYPE_T KeywordPool::determineTransitionType( const std::string& rWord ) const
 {
-   if( isOneOfTransitionKeyWords( rWord ) )
-      return TRANSITION;
-
-   if( isOneOfTransitionSelfKeyWords( rWord ) )
-      return TRANSITION_SELF;
-
-   if( isOneOfReturnKeyWords( rWord ) )
-      return RETURN;
-
-   if( isOneOfCallKeyWords( rWord ) )
-      return CALL;
+   const TYPE_T type = classify( rWord );
+   if( (type == DECLARE) || (type == INITIAL) )
+      return NON;
+   return type;
+}
 
-   return NON;
+/*!----------------------------------------------------------------------------
+ * Most of the words become rejected by their length and first character
+ * without creating a string for the lookup.
+ */
+bool KeywordPool::isContainedIn( const std::string& rText ) const
+{
+   const std::size_t size = rText.size();
+   std::size_t i = 0;
+   while( i < size )
+   {
+      if( !Keyword::isKeywordChar( rText[i] ) )
+      {
+         i++;
+         continue;
+      }
+      const std::size_t begin = i;
+      while( (i < size) && Keyword::isKeywordChar( rText[i] ) )
+         i++;
+      const std::size_t len = i - begin;
+      if( (len < m_minLength) || (len > m_maxLength) ||
+          !m_firstChars[static_cast<unsigned char>( rText[begin] )] )
+         continue;
+      if( m_index.count( rText.substr( begin, len ) ) != 0 )
+         return true;
+   }
+   return false;
 }
 
 //================================== EOF ======================================
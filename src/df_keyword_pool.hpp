@@ -12,6 +12,8 @@
 #ifndef _DF_KEYWORD_POOL_HPP
 #define _DF_KEYWORD_POOL_HPP
 
+#include <bitset>
+#include <unordered_map>
 #include "df_commandline.hpp"
 
 namespace DocFsm
@@ -28,10 +30,14 @@ public:
       TRANSITION,
       TRANSITION_SELF,
       CALL,
-      RETURN
+      RETURN,
+      DECLARE,
+      INITIAL
    };
 
 private:
+   using INDEX_T = std::unordered_map<std::string, TYPE_T>;
+
    class Option: public CLOP::OPTION_V
    {
    protected:
@@ -107,76 +113,112 @@ private:
    OverwriteReturn     m_overwriteReturn;
    ListKeywords        m_oListKeywords;
 
+   /*!
+    * @brief Frozen lookup of all keywords, built by setDefaultsIfEmpty()
+    *        after the command line has been parsed.
+    *
+    * Most of the recognized words are ordinary identifiers, they become
+    * rejected by their length and first character without hashing.
+    */
+   INDEX_T             m_index;
+   std::bitset<256>    m_firstChars;
+   std::size_t         m_minLength;
+   std::size_t         m_maxLength;
+
 public:
    KeywordPool( CommandlineParser& );
 
    bool setDefaultsIfEmpty( void );
 
-   void listKeywords( std::ostream&, const CONTAINER_T& );
+   void listKeywords( std::ostream&, const CONTAINER_T& ) const;
 
-   void listTransitionKeywords( std::ostream& rOut )
+   void listTransitionKeywords( std::ostream& rOut ) const
    {
       listKeywords( rOut, m_vTransitionKeywords );
       rOut << ", ";
       listKeywords( rOut, m_vTransitionSelfKeywords );
    }
 
-   void listDeclareKeywords( std::ostream& rOut )
+   void listDeclareKeywords( std::ostream& rOut ) const
    {
       listKeywords( rOut, m_vDeclareKeywords );
    }
 
-   void listInitialKeywords( std::ostream& rOut )
+   void listInitialKeywords( std::ostream& rOut ) const
    {
       listKeywords( rOut, m_vInitialKeywords );
    }
 
-   void listCallKeywords( std::ostream& rOut )
+   void listCallKeywords( std::ostream& rOut ) const
    {
       listKeywords( rOut, m_vCallKeywords );
    }
 
-   void listReturnKeywords( std::ostream& rOut )
+   void listReturnKeywords( std::ostream& rOut ) const
    {
       listKeywords( rOut, m_vReturnKeywords );
    }
 
    bool isInList( const CONTAINER_T& rvKeywords, const std::string& rWord );
 
-   bool isOneOfTransitionKeyWords( const std::string& word )
+   /*!
+    * @brief Returns the kind of the given keyword or NON if it isn't
+    *        a keyword.
+    */
+   TYPE_T classify( const std::string& rWord ) const
    {
-      return isInList( m_vTransitionKeywords, word );
+      if( (rWord.size() < m_minLength) || (rWord.size() > m_maxLength) ||
+          !m_firstChars[static_cast<unsigned char>( rWord[0] )] )
+         return NON;
+
+      const auto it = m_index.find( rWord );
+      if( it == m_index.end() )
+         return NON;
+      return it->second;
+   }
+
+   bool isOneOfTransitionKeyWords( const std::string& word ) const
+   {
+      return classify( word ) == TRANSITION;
    }
    
-   bool isOneOfTransitionSelfKeyWords( const std::string& word )
+   bool isOneOfTransitionSelfKeyWords( const std::string& word ) const
    {
-      return isInList( m_vTransitionSelfKeywords, word );
+      return classify( word ) == TRANSITION_SELF;
    }
 
-   bool isOneOfDeclareKeyWords( const std::string& word )
+   bool isOneOfDeclareKeyWords( const std::string& word ) const
    {
-      return isInList( m_vDeclareKeywords, word );
+      return classify( word ) == DECLARE;
    }
 
-   bool isOneOfInitialKeyWords( const std::string& word )
+   bool isOneOfInitialKeyWords( const std::string& word ) const
    {
-      return isInList( m_vInitialKeywords, word );
+      return classify( word ) == INITIAL;
    }
 
-   bool isOneOfCallKeyWords( const std::string& word )
+   bool isOneOfCallKeyWords( const std::string& word ) const
    {
-      return isInList( m_vCallKeywords, word );
+      return classify( word ) == CALL;
    }
 
-   bool isOneOfReturnKeyWords( const std::string& word )
+   bool isOneOfReturnKeyWords( const std::string& word ) const
    {
-      return isInList( m_vReturnKeywords, word );
+      return classify( word ) == RETURN;
    }
 
-   TYPE_T determineTransitionType( const std::string& word );
+   TYPE_T determineTransitionType( const std::string& word ) const;
+
+   /*!
+    * @brief Returns true if at least one keyword is contained as word in
+    *        the given text, e.g. in the not preprocessed source-code.
+    */
+   bool isContainedIn( const std::string& rText ) const;
 
 private:
    bool multipleCheck( void );
+   void freeze( void );
+   void addToIndex( const CONTAINER_T& rvKeywords, TYPE_T type );
 };
 
 } // End namespace DocFsm
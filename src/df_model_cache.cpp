@@ -0,0 +1,526 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!   @brief Module stores the collected model of each source-file in a      */
+/*!          cache-directory, so unchanged files needn't browsed again.      */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_model_cache.cpp                                              */
+/*! @see     df_model_cache.hpp                                              */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#ifndef __DOCFSM__
+ #include <fstream>
+ #include <vector>
+ #include <unistd.h>
+ #include <sys/stat.h>
+ #include <stdio.h>
+#endif
+#include "df_docfsm.hpp"
+#include "df_model_cache.hpp"
+
+using namespace DocFsm;
+
+/*!
+ * @brief Has to be incremented when the format of a cache-entry changes.
+ */
+#define CACHE_FORMAT_VERSION 1
+
+static const char c_cacheMagic[] = "DFMC";
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Reads the items of a cache-entry in the order they was written.
+ *
+ * Each reading beyond the end of the entry sets the error-flag and
+ * delivers zero, so the caller needs to check the flag only once at the end.
+ */
+class ModelCache::Reader
+{
+   const std::string& m_rData;
+   std::size_t        m_pos;
+   bool               m_error;
+
+public:
+   Reader( const std::string& rData )
+      :m_rData( rData )
+      ,m_pos( 0 )
+      ,m_error( false )
+   {}
+
+   uint64_t getNumber( std::size_t size )
+   {
+      if( m_error || (m_rData.size() - m_pos < size) )
+      {
+         m_error = true;
+         return 0;
+      }
+      uint64_t value = 0;
+      for( std::size_t i = 0; i < size; i++ )
+         value |= static_cast<uint64_t>( static_cast<uint8_t>( m_rData[m_pos++] )) << (i * 8);
+      return value;
+   }
+
+   bool getString( std::string& rStr )
+   {
+      const uint64_t size = getNumber( sizeof( uint32_t ) );
+      if( m_error || (m_rData.size() - m_pos < size) )
+      {
+         m_error = true;
+         return true;
+      }
+      rStr.assign( m_rData, m_pos, size );
+      m_pos += size;
+      return false;
+   }
+
+   void setError( void ) { m_error = true; }
+   bool isError( void ) const { return m_error; }
+   bool isEnd( void ) const { return m_pos == m_rData.size(); }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+ModelCache::OptionCacheDir::OptionCacheDir( ModelCache* pParent )
+   :m_pParent( pParent )
+{
+   m_hasArg   = REQUIRED_ARG;
+   m_shortOpt = '\0';
+   m_longOpt  = "cache-dir";
+   m_helpText = "Stores the collected states and transitions of each source-file\n"
+                "in the directory PARAM. In a further run the files which are\n"
+                "unchanged after preprocessing needn't browsed again.\n"
+                "The directory becomes created if not present.\n"
+                "E.g.: --cache-dir ~/.cache/docfsm";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int ModelCache::OptionCacheDir::onGiven( CLOP::PARSER* poParser )
+{
+   const std::string& rDir = poParser->getOptArg();
+   struct stat status;
+
+   if( rDir.empty() )
+   {
+      ERROR_MESSAGE( "Missing cache-directory!" );
+      return -1;
+   }
+
+   if( ::stat( rDir.c_str(), &status ) != 0 )
+   {
+      if( ::mkdir( rDir.c_str(), 0777 ) != 0 )
+      {
+         ERROR_MESSAGE( "Unable to create cache-directory \"" << rDir << "\"!" );
+         return -1;
+      }
+   }
+   else if( !S_ISDIR( status.st_mode ) )
+   {
+      ERROR_MESSAGE( "\"" << rDir << "\" is not a directory!" );
+      return -1;
+   }
+
+   m_pParent->m_dir = rDir;
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+ModelCache::ModelCache( StateCollector& rCollector,
+                        TransitionFinder& rFinder,
+                        KeywordPool& rKeywords,
+                        CommandlineParser& rParser )
+   :m_oOptionCacheDir( this )
+   ,m_rCollector( rCollector )
+   ,m_rFinder( rFinder )
+   ,m_rKeywords( rKeywords )
+   ,m_key( 0 )
+   ,m_sourceSize( 0 )
+   ,m_recording( false )
+   ,m_pErrBuffer( nullptr )
+{
+   rParser( m_oOptionCacheDir );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+ModelCache::~ModelCache( void )
+{
+   stopRecording();
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void ModelCache::stopRecording( void )
+{
+   if( !m_recording )
+      return;
+
+   std::cerr.rdbuf( m_pErrBuffer );
+   std::cerr << m_diagnostics.str();
+   m_recording = false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool ModelCache::makeKey( const std::string& rSource )
+{
+   TransitionFinder::CONTEXT_T context;
+   if( m_rFinder.getContext( context ) )
+      return true;
+
+   Hash hash;
+   hash.add( std::string( c_cacheMagic ) + DOCFSM_VERSION );
+   hash.add( CACHE_FORMAT_VERSION );
+
+   std::stringbuf keywords;
+   std::ostream keywordStream( &keywords );
+   m_rKeywords.listTransitionKeywords( keywordStream );
+   keywordStream << ';';
+   m_rKeywords.listDeclareKeywords( keywordStream );
+   keywordStream << ';';
+   m_rKeywords.listInitialKeywords( keywordStream );
+   keywordStream << ';';
+   m_rKeywords.listCallKeywords( keywordStream );
+   keywordStream << ';';
+   m_rKeywords.listReturnKeywords( keywordStream );
+   hash.add( keywords.str() );
+
+   hash.add( m_rFinder.noMerge() );
+   hash.add( m_rCollector.m_parseArgument );
+   hash.add( context.m_currentState );
+   hash.add( context.m_newState );
+   hash.add( context.m_braceCount );
+   hash.add( context.m_currentEffectivChar );
+   hash.add( context.m_lastEffectiveChar );
+
+   /*
+    * The names of the already known states decide whether a word of the
+    * source-code becomes a new state or not. Their order is irrelevant,
+    * therefore the hashes of the single names become summed up.
+    */
+   uint64_t names = 0;
+   for( const auto& rItem : m_rCollector.m_stateIndex )
+   {
+      Hash nameHash;
+      nameHash.add( rItem.first );
+      names += nameHash();
+   }
+   hash.add( names );
+   hash.add( m_rCollector.m_stateIndex.size() );
+
+   hash.add( rSource );
+   m_key = hash();
+   m_sourceSize = rSource.size();
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+std::string ModelCache::entryFileName( void ) const
+{
+   char name[sizeof( m_key ) * 2 + 1];
+   ::snprintf( name, sizeof( name ), "%016llx",
+               static_cast<unsigned long long>( m_key ) );
+   return m_dir + '/' + name + ".dfm";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void ModelCache::putNumber( std::string& rOut, uint64_t value, std::size_t size )
+{
+   for( std::size_t i = 0; i < size; i++ )
+   {
+      rOut += static_cast<char>( value & 0xFF );
+      value >>= 8;
+   }
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void ModelCache::putString( std::string& rOut, const std::string& rStr )
+{
+   putNumber( rOut, rStr.size(), sizeof( uint32_t ) );
+   rOut += rStr;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void ModelCache::putContext( std::string& rOut,
+                             const TransitionFinder::CONTEXT_T& rContext )
+{
+   putNumber( rOut, rContext.m_currentState, sizeof( uint8_t ) );
+   putNumber( rOut, rContext.m_newState, sizeof( uint8_t ) );
+   putNumber( rOut, rContext.m_braceCount, sizeof( uint32_t ) );
+   putNumber( rOut, rContext.m_currentEffectivChar, sizeof( uint8_t ) );
+   putNumber( rOut, rContext.m_lastEffectiveChar, sizeof( uint8_t ) );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief The DOT-keyword of a attribute is stored as its list and its
+ *        index within this list.
+ */
+bool ModelCache::putAttributes( std::string& rOut, const ATTR_LIST_T& rList )
+{
+   const DotKeywords::DOT_ATTR_LIST_T* const lists[] =
+   {
+      &DotKeywords::c_nodeAttributes,
+      &DotKeywords::c_edgeAttributes,
+      &DotKeywords::c_graphAttributes
+   };
+
+   putNumber( rOut, rList.size(), sizeof( uint32_t ) );
+   for( const auto& pAttr : rList )
+   {
+      std::size_t listNumber = 0;
+      while( (listNumber < (sizeof( lists ) / sizeof( lists[0] ))) &&
+             ((&pAttr->first < &lists[listNumber]->front()) ||
+              (&pAttr->first > &lists[listNumber]->back())) )
+         listNumber++;
+
+      if( listNumber == (sizeof( lists ) / sizeof( lists[0] )) )
+         return true;
+
+      putNumber( rOut, listNumber, sizeof( uint8_t ) );
+      putNumber( rOut, &pAttr->first - &lists[listNumber]->front(),
+                 sizeof( uint16_t ) );
+      putNumber( rOut, pAttr->second != nullptr, sizeof( uint8_t ) );
+      if( pAttr->second != nullptr )
+         putString( rOut, *pAttr->second );
+   }
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool ModelCache::getAttributes( Reader& rReader, Arena& rArena, ATTR_LIST_T& rList )
+{
+   const DotKeywords::DOT_ATTR_LIST_T* const lists[] =
+   {
+      &DotKeywords::c_nodeAttributes,
+      &DotKeywords::c_edgeAttributes,
+      &DotKeywords::c_graphAttributes
+   };
+
+   const uint64_t count = rReader.getNumber( sizeof( uint32_t ) );
+   for( uint64_t i = 0; (i < count) && !rReader.isError(); i++ )
+   {
+      const uint64_t listNumber = rReader.getNumber( sizeof( uint8_t ) );
+      const uint64_t index = rReader.getNumber( sizeof( uint16_t ) );
+      const bool hasValue = rReader.getNumber( sizeof( uint8_t ) ) != 0;
+      if( (listNumber >= (sizeof( lists ) / sizeof( lists[0] ))) ||
+          (index >= lists[listNumber]->size()) )
+      {
+         rReader.setError();
+         break;
+      }
+      std::string* pValue = nullptr;
+      if( hasValue )
+      {
+         pValue = rArena.create<std::string>();
+         if( rReader.getString( *pValue ) )
+            break;
+      }
+      rList.push_back( rArena.create<ATTR_T>( (*lists[listNumber])[index], pValue ) );
+   }
+   return rReader.isError();
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool ModelCache::load( const std::string& rFileName, const std::string& rSource )
+{
+   if( !isActive() )
+      return false;
+
+   m_key = 0;
+   if( makeKey( rSource ) )
+      return false;
+
+   std::ifstream file( entryFileName().c_str(), std::ios::in | std::ios::binary );
+   if( file )
+   {
+      std::string data;
+      file.seekg( 0, std::ios::end );
+      data.resize( file.tellg() );
+      file.seekg( 0, std::ios::beg );
+      file.read( &data[0], data.size() );
+
+      if( file )
+      {
+         Reader reader( data );
+         std::string magic;
+         TransitionFinder::CONTEXT_T context;
+         bool parseArgument;
+         std::string diagnostics;
+         std::vector<StateGraph*> vpStates;
+
+         reader.getString( magic );
+         const bool formatOk =
+                  (magic == c_cacheMagic) &&
+                  (reader.getNumber( sizeof( uint32_t ) ) == CACHE_FORMAT_VERSION) &&
+                  (reader.getNumber( sizeof( uint64_t ) ) == m_key) &&
+                  (reader.getNumber( sizeof( uint64_t ) ) == m_sourceSize);
+
+         context.m_currentState = reader.getNumber( sizeof( uint8_t ) );
+         context.m_newState = reader.getNumber( sizeof( uint8_t ) );
+         context.m_braceCount = static_cast<int32_t>( reader.getNumber( sizeof( uint32_t ) ) );
+         context.m_currentEffectivChar = reader.getNumber( sizeof( uint8_t ) );
+         context.m_lastEffectiveChar = reader.getNumber( sizeof( uint8_t ) );
+         parseArgument = reader.getNumber( sizeof( uint8_t ) ) != 0;
+         reader.getString( diagnostics );
+
+         StateCollector::MODULE* pModule = nullptr;
+         const uint64_t stateCount = reader.getNumber( sizeof( uint32_t ) );
+         if( formatOk && (stateCount > 0) )
+            pModule = new StateCollector::MODULE( rFileName );
+
+         for( uint64_t i = 0; formatOk && (i < stateCount) && !reader.isError(); i++ )
+         {
+            std::string name;
+            if( reader.getString( name ) )
+               break;
+            /*
+             * Can't be happen when the key matches, nevertheless the
+             * state names have to be unique.
+             */
+            if( m_rCollector.m_stateIndex.count( name ) != 0 )
+            {
+               reader.setError();
+               break;
+            }
+            StateGraph* pState = m_rCollector.m_oArena.create<StateGraph>( &m_rCollector, name );
+            pModule->m_vpFsm.back()->getStateList().push_back( pState );
+            vpStates.push_back( pState );
+            getAttributes( reader, m_rCollector.m_oArena, pState->getAttrList() );
+         }
+
+         for( auto& pState : vpStates )
+         {
+            if( reader.isError() )
+               break;
+            const uint64_t transitionCount = reader.getNumber( sizeof( uint32_t ) );
+            for( uint64_t i = 0; (i < transitionCount) && !reader.isError(); i++ )
+            {
+               const uint64_t target = reader.getNumber( sizeof( uint32_t ) );
+               if( target >= vpStates.size() )
+               {
+                  reader.setError();
+                  break;
+               }
+               TransitionGraph* pTransition =
+                  m_rCollector.m_oArena.create<TransitionGraph>( vpStates[target] );
+               pState->addTransition( pTransition );
+               getAttributes( reader, m_rCollector.m_oArena, pTransition->getAttrList() );
+            }
+         }
+
+         if( formatOk && !reader.isError() && reader.isEnd() )
+         {
+            if( pModule != nullptr )
+            {
+               const std::size_t module = m_rCollector.m_vpModules.size();
+               m_rCollector.m_vpModules.push_back( pModule );
+               for( auto& pState : vpStates )
+                  m_rCollector.m_stateIndex[pState->getName()] = { pState, module };
+            }
+            m_rFinder.setContext( context );
+            m_rCollector.m_parseArgument = parseArgument;
+            std::cerr << diagnostics;
+            return true;
+         }
+
+         delete pModule;
+      }
+   }
+
+   /*
+    * Cache miss: the diagnostic messages of the following processing
+    * become recorded, so they can be stored in the cache-entry.
+    */
+   m_diagnostics.str( std::string() );
+   m_pErrBuffer = std::cerr.rdbuf( &m_diagnostics );
+   m_recording = true;
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void ModelCache::store( void )
+{
+   if( !m_recording )
+      return;
+
+   stopRecording();
+
+   TransitionFinder::CONTEXT_T context;
+   if( m_rCollector.hasForeignAccess() || m_rFinder.getContext( context ) )
+      return;
+
+   std::string data;
+   putString( data, c_cacheMagic );
+   putNumber( data, CACHE_FORMAT_VERSION, sizeof( uint32_t ) );
+   putNumber( data, m_key, sizeof( uint64_t ) );
+   putNumber( data, m_sourceSize, sizeof( uint64_t ) );
+   putContext( data, context );
+   putNumber( data, m_rCollector.m_parseArgument, sizeof( uint8_t ) );
+   putString( data, m_diagnostics.str() );
+
+   if( m_rCollector.m_vpModules.size() <= m_rCollector.m_currentModule )
+   { /*
+      * The file doesn't contain any state.
+      */
+      putNumber( data, 0, sizeof( uint32_t ) );
+   }
+   else
+   {
+      StateCollector::STATES& rStates = m_rCollector.get();
+      std::unordered_map<const StateGraph*, std::size_t> stateNumbers;
+      std::size_t stateNumber = 0;
+      for( const auto& pState : rStates )
+         stateNumbers[pState] = stateNumber++;
+
+      putNumber( data, rStates.size(), sizeof( uint32_t ) );
+      for( const auto& pState : rStates )
+      {
+         putString( data, pState->getName() );
+         if( putAttributes( data, pState->getAttrList() ) )
+            return;
+      }
+      for( const auto& pState : rStates )
+      {
+         putNumber( data, pState->getTransitionList().size(), sizeof( uint32_t ) );
+         for( const auto& pTransition : pState->getTransitionList() )
+         {
+            const auto it = stateNumbers.find( pTransition->getTargetState() );
+            if( it == stateNumbers.end() )
+               return;
+            putNumber( data, it->second, sizeof( uint32_t ) );
+            if( putAttributes( data, pTransition->getAttrList() ) )
+               return;
+         }
+      }
+   }
+
+   /*
+    * Writing in a temporary file followed by renaming, so a concurrent
+    * running DocFsm will never see an incomplete entry.
+    */
+   const std::string fileName = entryFileName();
+   const std::string tempName = fileName + '.' + std::to_string( ::getpid() );
+   std::ofstream file( tempName.c_str(), std::ios::out | std::ios::binary |
+                                         std::ios::trunc );
+   file.write( data.data(), data.size() );
+   file.close();
+   if( !file || (::rename( tempName.c_str(), fileName.c_str() ) != 0) )
+   {
+      ::unlink( tempName.c_str() );
+      WARNING_MESSAGE( "Unable to write cache-entry \"" << fileName << "\"!" );
+   }
+}
+
+//================================== EOF ======================================
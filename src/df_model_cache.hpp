@@ -0,0 +1,106 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!   @brief Module stores the collected model of each source-file in a      */
+/*!          cache-directory, so unchanged files needn't browsed again.      */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_model_cache.hpp                                              */
+/*! @see     df_model_cache.cpp                                              */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#ifndef _DF_MODEL_CACHE_HPP
+#define _DF_MODEL_CACHE_HPP
+
+#ifndef __DOCFSM__
+ #include <stdint.h>
+ #include <string>
+ #include <sstream>
+ #include "df_commandline.hpp"
+ #include "df_hash.hpp"
+ #include "df_keyword_pool.hpp"
+ #include "df_state_collector.hpp"
+ #include "df_transition_finder.hpp"
+#endif
+
+namespace DocFsm
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Cache of the states and transitions which are collected from
+ *        a source-file.
+ *
+ * The key of a cache-entry is a hash over the preparsed source-code, the
+ * keywords of the KeywordPool, the options which influence the collecting
+ * and the names of the states which are already known from the previous
+ * files. So a cache hit delivers the same model as the browse passes
+ * of the StateCollector and the TransitionFinder would do.
+ *
+ * Files whose processing has touched states of previous files will not
+ * stored, because their result can't be described by an own module alone.
+ */
+class ModelCache
+{
+   class OptionCacheDir: public CLOP::OPTION_V
+   {
+      ModelCache*   m_pParent;
+   public:
+      OptionCacheDir( ModelCache* pParent );
+      int onGiven( CLOP::PARSER* poParser ) override;
+   };
+
+   class Reader;
+
+   OptionCacheDir    m_oOptionCacheDir;
+   StateCollector&   m_rCollector;
+   TransitionFinder& m_rFinder;
+   KeywordPool&      m_rKeywords;
+   std::string       m_dir;
+   uint64_t          m_key;
+   uint64_t          m_sourceSize;
+   bool              m_recording;
+   std::stringbuf    m_diagnostics;
+   std::streambuf*   m_pErrBuffer;
+
+public:
+   ModelCache( StateCollector&, TransitionFinder&, KeywordPool&,
+               CommandlineParser& );
+   ~ModelCache( void );
+
+   bool isActive( void ) const { return !m_dir.empty(); }
+
+   /*!
+    * @brief Looks for the model of the given preparsed source-code in the
+    *        cache and adds it to the StateCollector when found.
+    *
+    * In the case of a miss the diagnostic messages of the following
+    * processing become recorded until store() is called, so they can be
+    * repeated by a later hit.
+    * @retval true Model was found, the file doesn't need a further
+    *              processing.
+    */
+   bool load( const std::string& rFileName, const std::string& rSource );
+
+   /*!
+    * @brief Stores the model of the file which was processed after the
+    *        last call of load(), if the model is self-contained.
+    */
+   void store( void );
+
+private:
+   bool makeKey( const std::string& rSource );
+   void stopRecording( void );
+   std::string entryFileName( void ) const;
+   static void putNumber( std::string& rOut, uint64_t value, std::size_t size );
+   static void putString( std::string& rOut, const std::string& rStr );
+   static bool putAttributes( std::string& rOut, const ATTR_LIST_T& rList );
+   static void putContext( std::string& rOut,
+                           const TransitionFinder::CONTEXT_T& rContext );
+   static bool getAttributes( Reader& rReader, Arena& rArena, ATTR_LIST_T& rList );
+};
+
+} // End namespace DocFsm
+#endif // ifndef _DF_MODEL_CACHE_HPP
+//================================== EOF ======================================
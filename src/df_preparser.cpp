@@ -11,6 +11,12 @@
 /*! @date    05.11.2017                                                      */
 /*  Updates:                                                                 */
 /*****************************************************************************/
+#ifndef __DOCFSM__
+ #include <string.h>
+ #ifdef __SSE2__
+  #include <emmintrin.h>
+ #endif
+#endif
 #include "df_preparser.hpp"
 
 using namespace DocFsm;
@@ -188,7 +194,7 @@ bool Preparser::InMacro::onDo( char c )
 ///////////////////////////////////////////////////////////////////////////////
 /*!----------------------------------------------------------------------------
 */
-Preparser::Preparser( std::istream& rInput, std::string& rOutput )
+Preparser::Preparser( const char* pInput, std::size_t size, std::string& rOutput )
        :FSM_INIT_STATE( InCode )
        ,FSM_INIT_STATE( InQuotes )
        ,FSM_INIT_STATE( StartComment )
@@ -198,22 +204,97 @@ Preparser::Preparser( std::istream& rInput, std::string& rOutput )
        ,FSM_INIT_FSM( InCode, label='Start', color=blue, fontcolor=blue )
        ,m_lastChar( '\0' )
        ,m_rOutput( rOutput )
-       ,m_rInput( rInput )
+       ,m_pInput( pInput )
+       ,m_inputSize( size )
 {
    m_rOutput.clear();
+   m_rOutput.reserve( size );
 }
 
 /*!----------------------------------------------------------------------------
-*/
+ * Returns a pointer to the first character of a, b or c in the range
+ * pBegin to pEnd, or pEnd if none of them is found.
+ */
+const char* Preparser::findFirstOf( const char* pBegin, const char* pEnd,
+                                    const char a, const char b, const char c )
+{
+#ifdef __SSE2__
+   const __m128i va = _mm_set1_epi8( a );
+   const __m128i vb = _mm_set1_epi8( b );
+   const __m128i vc = _mm_set1_epi8( c );
+   while( (pEnd - pBegin) >= static_cast<std::ptrdiff_t>(sizeof( __m128i )) )
+   {
+      const __m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i*>(pBegin) );
+      const int mask = _mm_movemask_epi8( _mm_or_si128( _mm_or_si128(
+                                                         _mm_cmpeq_epi8( v, va ),
+                                                         _mm_cmpeq_epi8( v, vb )),
+                                                         _mm_cmpeq_epi8( v, vc )));
+      if( mask != 0 )
+         return pBegin + __builtin_ctz( mask );
+      pBegin += sizeof( __m128i );
+   }
+#endif
+   for( ; pBegin < pEnd; pBegin++ )
+   {
+      if( (*pBegin == a) || (*pBegin == b) || (*pBegin == c) )
+         return pBegin;
+   }
+   return pEnd;
+}
+
+/*!----------------------------------------------------------------------------
+ * Returns a pointer to the next character which could cause a transition
+ * or a output different from the current state's default behavior.
+ * All characters before it will simply copied in the state InCode or
+ * ignored in all other states.
+ */
+const char* Preparser::findNextRelevant( const char* pBegin, const char* pEnd ) const
+{
+   if( m_pCurrentState == &m_stoInCode )
+      return findFirstOf( pBegin, pEnd, '#', '"', '/' );
+
+   if( m_pCurrentState == &m_stoInBlockComment )
+      return findFirstOf( pBegin, pEnd, '\n', '/', '/' );
+
+   const char* pFound;
+   if( m_pCurrentState == &m_stoInQuotes )
+      pFound = static_cast<const char*>(::memchr( pBegin, '"', pEnd - pBegin ));
+   else if( (m_pCurrentState == &m_stoInLineComment) ||
+            (m_pCurrentState == &m_stoInMacro) )
+      pFound = static_cast<const char*>(::memchr( pBegin, '\n', pEnd - pBegin ));
+   else
+      return pBegin;
+
+   return (pFound != nullptr)? pFound : pEnd;
+}
+
+/*!----------------------------------------------------------------------------
+ * Fast path: The runs of characters which doesn't concern the current state
+ * will skipped respectively copied as a whole. Only the relevant characters
+ * are passed to the FSM. Because m_lastChar is always the previous
+ * character of the input, the result is the same as if each character
+ * would passed to the FSM.
+ */
 bool Preparser::remove( void )
 {
-   std::for_each( std::istreambuf_iterator<char>(m_rInput),
-                  std::istreambuf_iterator<char>(),
-                  [this] (char c) -> void
-                  {
-                     m_pCurrentState->onDo( c );
-                     m_lastChar = c;
-                  });
+   const char* pCurrent = m_pInput;
+   const char* const pEnd = m_pInput + m_inputSize;
+
+   while( pCurrent < pEnd )
+   {
+      const char* pNext = findNextRelevant( pCurrent, pEnd );
+      if( pNext != pCurrent )
+      {
+         if( m_pCurrentState == &m_stoInCode )
+            m_rOutput.append( pCurrent, pNext - pCurrent );
+         m_lastChar = pNext[-1];
+         pCurrent = pNext;
+         if( pCurrent == pEnd )
+            break;
+      }
+      m_pCurrentState->onDo( *pCurrent );
+      m_lastChar = *pCurrent++;
+   }
    return false;
 }
 
@@ -53,15 +53,31 @@ class Preparser
    State*           m_pCurrentState;
    char             m_lastChar;
    std::string&     m_rOutput;
-   std::istream&    m_rInput;
+   const char*      m_pInput;
+   std::size_t      m_inputSize;
 
 public:
-   Preparser( std::istream& rInput, std::string& rOutput );
+   /*!
+    * @brief Reads the source-code from the contiguous memory area of
+    *        size bytes beginning at pInput. The area isn't copied, so it has
+    *        to remain valid until remove() has been finished.
+    */
+   Preparser( const char* pInput, std::size_t size, std::string& rOutput );
+
+   Preparser( const std::string& rInput, std::string& rOutput )
+      :Preparser( rInput.data(), rInput.size(), rOutput )
+   {}
+
    bool remove( void );
    bool operator()( void )
    {
       return remove();
    }
+
+private:
+   const char* findNextRelevant( const char* pBegin, const char* pEnd ) const;
+   static const char* findFirstOf( const char* pBegin, const char* pEnd,
+                                   const char a, const char b, const char c );
 };
 
 } // End namespace DocFsm
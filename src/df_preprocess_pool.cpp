@@ -0,0 +1,283 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!  @brief Module invokes the preprocessor and the preparser for each       */
+/*!         source-file, optionally concurrently in worker threads.          */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_preprocess_pool.cpp                                          */
+/*! @see     df_preprocess_pool.hpp                                          */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#ifndef __DOCFSM__
+ #include <stdlib.h>
+ #include <fstream>
+#endif
+#include "df_docfsm.hpp"
+#include "df_preparser.hpp"
+#include "df_preprocess_pool.hpp"
+
+using namespace DocFsm;
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+PreprocessPool::OptionJobs::OptionJobs( PreprocessPool* pParent )
+   :m_pParent( pParent )
+{
+   m_hasArg   = REQUIRED_ARG;
+   m_shortOpt = 'j';
+   m_longOpt  = "jobs";
+   m_helpText = "Runs the preprocessor for PARAM source-files concurrently.\n"
+                "If PARAM is 0 so the number of CPU-cores will used.\n"
+                "The output is the same as without this option.\n"
+                "E.g.: -j 8 *.cpp";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int PreprocessPool::OptionJobs::onGiven( CLOP::PARSER* poParser )
+{
+   char* pEnd;
+   long jobs = ::strtol( poParser->getOptArg().c_str(), &pEnd, 10 );
+   if( poParser->getOptArg().empty() || (*pEnd != '\0') || (jobs < 0) )
+   {
+      ERROR_MESSAGE( "Invalid number of jobs: \"" << poParser->getOptArg()
+                     << "\"" );
+      return -1;
+   }
+   if( jobs == 0 )
+      jobs = std::thread::hardware_concurrency();
+   m_pParent->m_jobs = (jobs > 0)? jobs : 1;
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+PreprocessPool::OptionNoPrefilter::OptionNoPrefilter( PreprocessPool* pParent )
+   :m_pParent( pParent )
+{
+   m_hasArg   = NO_ARG;
+   m_shortOpt = '\0';
+   m_longOpt  = "no-prefilter";
+   m_helpText = "Preprocesses each source-file, also when it doesn't contain\n"
+                "any keyword before preprocessing. Necessary when keywords\n"
+                "become produced by macros of included files only.";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int PreprocessPool::OptionNoPrefilter::onGiven( CLOP::PARSER* poParser )
+{
+   m_pParent->m_prefilter = false;
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+PreprocessPool::Worker::Worker( PreprocessPool& rParent )
+   :m_rParent( rParent )
+   ,m_errStream( &m_errBuffer )
+   ,m_oCppProcess( rParent.m_oCppCaller, m_cppOutput, m_errStream )
+   ,m_thread( &Worker::run, this )
+{
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void PreprocessPool::Worker::join( void )
+{
+   if( m_thread.joinable() )
+      m_thread.join();
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void PreprocessPool::Worker::run( void )
+{
+   std::unique_lock<std::mutex> lock( m_rParent.m_mutex );
+   while( true )
+   {
+      m_rParent.m_condition.wait( lock, [this]
+      {
+         return m_rParent.m_abort ||
+                (m_rParent.m_next >= m_rParent.m_vJobs.size()) ||
+                m_rParent.isInWindow();
+      });
+
+      if( m_rParent.m_abort || (m_rParent.m_next >= m_rParent.m_vJobs.size()) )
+         return;
+
+      const std::size_t index = m_rParent.m_next++;
+      JOB_T& rJob = m_rParent.m_vJobs[index];
+      const std::string& rFileName = (*m_rParent.m_pFileNameList)[index];
+      lock.unlock();
+
+      bool error;
+      try
+      {
+         error = m_rParent.preprocess( m_oCppProcess, m_cppOutput,
+                                       rFileName, rJob.m_output,
+                                       rJob.m_statistics );
+      }
+      catch( ... )
+      {
+         m_errStream << RED BOLD "ERROR: Exception while preprocessing \""
+                     << rFileName << "\": perhaps not enough memory!"
+                     NORMAL << std::endl;
+         error = true;
+      }
+
+      lock.lock();
+      rJob.m_errors = m_errBuffer.str();
+      m_errBuffer.str( std::string() );
+      rJob.m_error = error;
+      rJob.m_ready = true;
+      m_rParent.m_condition.notify_all();
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+PreprocessPool::PreprocessPool( CommandlineParser& rParser,
+                                const KeywordPool& rKeywords )
+   :m_oCppCaller( m_cppOutput, rParser )
+   ,m_oOptionJobs( this )
+   ,m_oOptionNoPrefilter( this )
+   ,m_rKeywords( rKeywords )
+   ,m_prefilter( true )
+   ,m_jobs( 1 )
+   ,m_pFileNameList( nullptr )
+   ,m_next( 0 )
+   ,m_consumed( 0 )
+   ,m_abort( false )
+{
+   rParser( m_oOptionJobs )( m_oOptionNoPrefilter );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+PreprocessPool::~PreprocessPool( void )
+{
+   {
+      std::lock_guard<std::mutex> lock( m_mutex );
+      m_abort = true;
+   }
+   m_condition.notify_all();
+
+   for( auto& pWorker : m_vpWorkers )
+   {
+      pWorker->join();
+      delete pWorker;
+   }
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool PreprocessPool::start( const FILE_NAME_LIST_T& rFileNameList )
+{
+   m_pFileNameList = &rFileNameList;
+
+   if( m_jobs > rFileNameList.size() )
+      m_jobs = rFileNameList.size();
+
+   if( m_jobs <= 1 )
+      return false;
+
+   m_vJobs.resize( rFileNameList.size() );
+   for( unsigned int i = 0; i < m_jobs; i++ )
+      m_vpWorkers.push_back( new Worker( *this ) );
+
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool PreprocessPool::get( std::size_t index, std::string& rOutput,
+                          Statistics::PREPROCESS_T& rStatistics )
+{
+   assert( m_pFileNameList != nullptr );
+   assert( index < m_pFileNameList->size() );
+
+   if( m_vpWorkers.empty() )
+      return preprocess( m_oCppCaller, m_cppOutput,
+                         (*m_pFileNameList)[index], rOutput, rStatistics );
+
+   std::unique_lock<std::mutex> lock( m_mutex );
+   JOB_T& rJob = m_vJobs[index];
+   m_condition.wait( lock, [&rJob] { return rJob.m_ready; } );
+
+   std::cerr << rJob.m_errors;
+   rStatistics = rJob.m_statistics;
+   rOutput.swap( rJob.m_output );
+   std::string().swap( rJob.m_output );
+   m_consumed = index + 1;
+   m_condition.notify_all();
+
+   return rJob.m_error;
+}
+
+/*!----------------------------------------------------------------------------
+ * A file which can't be read passes, so the preprocessor reports the error.
+ */
+bool PreprocessPool::hasKeywords( const std::string& rFileName ) const
+{
+   std::ifstream file( rFileName.c_str(), std::ios::in | std::ios::binary );
+   if( !file )
+      return true;
+   std::string source;
+   file.seekg( 0, std::ios::end );
+   const std::streamoff size = file.tellg();
+   if( size < 0 )
+      return true;
+   source.resize( size );
+   file.seekg( 0, std::ios::beg );
+   file.read( &source[0], source.size() );
+   if( !file )
+      return true;
+   return m_rKeywords.isContainedIn( source );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool PreprocessPool::preprocess( CppExecution& rCpp, std::string& rCppOutput,
+                                 const std::string& rFileName,
+                                 std::string& rOutput,
+                                 Statistics::PREPROCESS_T& rStatistics ) const
+{
+   rStatistics.m_cpp.start();
+   if( m_prefilter && !hasKeywords( rFileName ) )
+   {
+      rStatistics.m_cpp.stop();
+      rStatistics.m_prefiltered = true;
+      rOutput.clear();
+      return false;
+   }
+
+   /*
+    * The buffer keeps its capacity from the previous file, so it becomes
+    * allocated only once for files of similar size.
+    */
+   rCppOutput.clear();
+
+   const bool error = rCpp.preprocess( rFileName );
+   rStatistics.m_cpp.stop();
+   rStatistics.m_cpp.addCpu( rCpp.getChildCpuTime() );
+   if( error )
+      return true;
+   rStatistics.m_preprocessedBytes = rCppOutput.size();
+
+   rStatistics.m_preparse.start();
+   Preparser preparser( rCppOutput, rOutput );
+   const bool ret = preparser();
+   rStatistics.m_preparse.stop();
+   rStatistics.m_preparsedBytes = rOutput.size();
+   return ret;
+}
+
+//================================== EOF ======================================
@@ -0,0 +1,151 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!  @brief Module invokes the preprocessor and the preparser for each       */
+/*!         source-file, optionally concurrently in worker threads.          */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_preprocess_pool.hpp                                          */
+/*! @see     df_preprocess_pool.cpp                                          */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#ifndef _DF_PREPROCESS_POOL_HPP
+#define _DF_PREPROCESS_POOL_HPP
+
+#ifndef __DOCFSM__
+ #include <vector>
+ #include <sstream>
+ #include <thread>
+ #include <mutex>
+ #include <condition_variable>
+ #include "df_commandline.hpp"
+ #include "df_cpp_caller.hpp"
+ #include "df_keyword_pool.hpp"
+ #include "df_statistics.hpp"
+#endif
+
+namespace DocFsm
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Delivers the preprocessed and preparsed source-code of each file
+ *        of the command line.
+ *
+ * If the option "--jobs" is given with a value greater than one, so the
+ * preprocessor and the preparser will run concurrently in worker threads.
+ * Nevertheless the results will delivered in the order of the command line,
+ * so the further processing remains the same as in the serial case.
+ *
+ * Files whose not preprocessed source-code doesn't contain any keyword
+ * become rejected before invoking the preprocessor, unless the option
+ * "--no-prefilter" is given.
+ */
+class PreprocessPool
+{
+   using FILE_NAME_LIST_T = std::vector<std::string>;
+
+   class OptionJobs: public CLOP::OPTION_V
+   {
+      PreprocessPool*   m_pParent;
+   public:
+      OptionJobs( PreprocessPool* pParent );
+      int onGiven( CLOP::PARSER* poParser ) override;
+   };
+
+   class OptionNoPrefilter: public CLOP::OPTION_V
+   {
+      PreprocessPool*   m_pParent;
+   public:
+      OptionNoPrefilter( PreprocessPool* pParent );
+      int onGiven( CLOP::PARSER* poParser ) override;
+   };
+
+   struct JOB_T
+   {
+      std::string  m_output;
+      std::string  m_errors;
+      Statistics::PREPROCESS_T m_statistics;
+      bool         m_ready;
+      bool         m_error;
+
+      JOB_T( void )
+         :m_ready( false )
+         ,m_error( false )
+      {}
+   };
+
+   class Worker
+   {
+      PreprocessPool&   m_rParent;
+      std::string       m_cppOutput;
+      std::stringbuf    m_errBuffer;
+      std::ostream      m_errStream;
+      CppProcess        m_oCppProcess;
+      std::thread       m_thread;
+
+   public:
+      Worker( PreprocessPool& rParent );
+      void join( void );
+
+   private:
+      void run( void );
+   };
+
+   std::string              m_cppOutput;
+   CppCaller                m_oCppCaller;
+   OptionJobs               m_oOptionJobs;
+   OptionNoPrefilter        m_oOptionNoPrefilter;
+   const KeywordPool&       m_rKeywords;
+   bool                     m_prefilter;
+   unsigned int             m_jobs;
+   const FILE_NAME_LIST_T*  m_pFileNameList;
+   std::vector<JOB_T>       m_vJobs;
+   std::vector<Worker*>     m_vpWorkers;
+   std::size_t              m_next;
+   std::size_t              m_consumed;
+   bool                     m_abort;
+   std::mutex               m_mutex;
+   std::condition_variable  m_condition;
+
+public:
+   PreprocessPool( CommandlineParser& rParser, const KeywordPool& rKeywords );
+   ~PreprocessPool( void );
+
+   /*!
+    * @brief Starts the worker threads if more than one job is desired.
+    */
+   bool start( const FILE_NAME_LIST_T& rFileNameList );
+
+   /*!
+    * @brief Delivers the preparsed source-code of the file with the
+    *        given index of the file-list.
+    *
+    * In the case of worker threads this function blocks until the
+    * corresponding file is ready.
+    * @param rStatistics Receives the times and sizes of the preprocessor
+    *                    and the preparser. A file rejected by the keyword
+    *                    prefilter is marked there, its output is empty.
+    * @retval true Error
+    */
+   bool get( std::size_t index, std::string& rOutput,
+             Statistics::PREPROCESS_T& rStatistics );
+
+   CppCaller& getCppCaller( void ) { return m_oCppCaller; }
+
+private:
+   bool preprocess( CppExecution& rCpp, std::string& rCppOutput,
+                    const std::string& rFileName,
+                    std::string& rOutput,
+                    Statistics::PREPROCESS_T& rStatistics ) const;
+   bool hasKeywords( const std::string& rFileName ) const;
+   bool isInWindow( void ) const
+   {
+      return m_next < m_consumed + 2 * m_jobs;
+   }
+};
+
+} // End namespace DocFsm
+#endif // ifndef _DF_PREPROCESS_POOL_HPP
+//================================== EOF ======================================
@@ -0,0 +1,551 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!   @brief Module runs DocFsm as server on a Unix domain socket            */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_server.cpp                                                   */
+/*! @see     df_server.hpp                                                   */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <time.h>
+
+#include "df_docfsm.hpp"
+#include "df_server.hpp"
+
+using namespace DocFsm;
+
+/*!
+ * @brief Maximum size of a request in bytes.
+ */
+#define MAX_REQUEST_SIZE (1024 * 1024)
+
+/*!
+ * @brief Default of the maximum run-time of a request in seconds.
+ */
+#define DEFAULT_REQUEST_TIMEOUT 60
+
+/*!
+ * @brief Long names of the options which are reserved for the server's
+ *        command line. In a request they would block the server or let
+ *        the client write files at any place.
+ */
+static const char* const g_apReservedOptions[] =
+{
+   "serve",
+   "serve-timeout",
+   "watch",
+   "output",
+   "outdir",
+   "cache-dir",
+   "cpp-cache"
+};
+
+static volatile sig_atomic_t g_stop = 0;
+
+/*!----------------------------------------------------------------------------
+*/
+static void onStopSignal( int )
+{
+   g_stop = 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+Server::OptionServe::OptionServe( Server* pParent )
+   :m_pParent( pParent )
+{
+   m_hasArg   = REQUIRED_ARG;
+   m_shortOpt = '\0';
+   m_longOpt  = "serve";
+   m_helpText = "Runs DocFsm as server listening on the Unix domain socket\n"
+                "PARAM. Each request contains the working directory and the\n"
+                "arguments of a DocFsm-call, the further options of the\n"
+                "server's command line become prepended to them.\n"
+                "A request must not contain the options \"--serve\",\n"
+                "\"--serve-timeout\", \"--watch\", \"-o\", \"--outdir\",\n"
+                "\"--cache-dir\" and \"--cpp-cache\", they are reserved\n"
+                "for the server.\n"
+                "The server terminates by SIGTERM or SIGINT.\n"
+                "E.g.: --serve /tmp/docfsm.sock --cache-dir ~/.cache/docfsm";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int Server::OptionServe::onGiven( CLOP::PARSER* poParser )
+{
+   if( poParser->getOptArg().empty() )
+   {
+      ERROR_MESSAGE( "Missing socket name for server!" );
+      return -1;
+   }
+   m_pParent->m_socketName = poParser->getOptArg();
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+Server::OptionTimeout::OptionTimeout( Server* pParent )
+   :m_pParent( pParent )
+{
+   m_hasArg   = REQUIRED_ARG;
+   m_shortOpt = '\0';
+   m_longOpt  = "serve-timeout";
+   m_helpText = "Maximum run-time of a request of the server in seconds,\n"
+                "a request which takes longer becomes killed.\n"
+                "Default: " TO_STRING( DEFAULT_REQUEST_TIMEOUT );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int Server::OptionTimeout::onGiven( CLOP::PARSER* poParser )
+{
+   char* pEnd;
+   long timeout = ::strtol( poParser->getOptArg().c_str(), &pEnd, 10 );
+   if( poParser->getOptArg().empty() || (*pEnd != '\0') || (timeout <= 0) )
+   {
+      ERROR_MESSAGE( "Invalid timeout of requests: \"" << poParser->getOptArg()
+                     << "\"" );
+      return -1;
+   }
+   m_pParent->m_timeout = timeout;
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+Server::Server( CommandlineParser& rParser )
+   :m_oOptionServe( this )
+   ,m_oOptionTimeout( this )
+   ,m_rParser( rParser )
+   ,m_fd( -1 )
+   ,m_timeout( DEFAULT_REQUEST_TIMEOUT )
+{
+   rParser( m_oOptionServe );
+   rParser( m_oOptionTimeout );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+Server::~Server( void )
+{
+   if( m_fd < 0 )
+      return;
+   ::close( m_fd );
+   ::unlink( m_socketName.c_str() );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool Server::listen( void )
+{
+   struct sockaddr_un address;
+   ::memset( &address, 0, sizeof( address ) );
+   address.sun_family = AF_UNIX;
+   if( m_socketName.size() >= sizeof( address.sun_path ) )
+   {
+      ERROR_MESSAGE( "Socket name \"" << m_socketName << "\" is too long!" );
+      return true;
+   }
+   ::strcpy( address.sun_path, m_socketName.c_str() );
+
+   int fd = ::socket( AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0 );
+   if( fd < 0 )
+   {
+      ERROR_MESSAGE( "Unable to create socket: " << ::strerror( errno ) );
+      return true;
+   }
+
+   /*
+    * A socket file left by a terminated server will replaced,
+    * but not the one of a running server.
+    */
+   if( ::connect( fd, reinterpret_cast<struct sockaddr*>(&address),
+                  sizeof( address ) ) == 0 )
+   {
+      ERROR_MESSAGE( "Socket \"" << m_socketName
+                     << "\" is already served by a further process!" );
+      ::close( fd );
+      return true;
+   }
+   ::unlink( m_socketName.c_str() );
+
+   if( (::bind( fd, reinterpret_cast<struct sockaddr*>(&address),
+                sizeof( address ) ) != 0) || (::listen( fd, 16 ) != 0) )
+   {
+      ERROR_MESSAGE( "Unable to listen on socket \"" << m_socketName << "\": "
+                     << ::strerror( errno ) );
+      ::close( fd );
+      return true;
+   }
+   m_fd = fd;
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int Server::operator()( int argc, char** ppArgv, RUN_FUNCTION_T run )
+{
+   ARG_LIST_T defaults;
+   for( int i = 1; i < argc; i++ )
+   {
+      if( ::strcmp( ppArgv[i], "--serve" ) == 0 )
+      {
+         i++;
+         continue;
+      }
+      if( ::strncmp( ppArgv[i], "--serve=", 8 ) == 0 )
+         continue;
+      defaults.push_back( ppArgv[i] );
+   }
+   defaults.insert( defaults.begin(), ppArgv[0] );
+
+   if( listen() )
+      return EXIT_FAILURE;
+
+   /*
+    * Without SA_RESTART, so accept() returns by the signals.
+    */
+   struct sigaction action;
+   ::memset( &action, 0, sizeof( action ) );
+   action.sa_handler = onStopSignal;
+   ::sigaction( SIGTERM, &action, nullptr );
+   ::sigaction( SIGINT, &action, nullptr );
+   ::signal( SIGPIPE, SIG_IGN );
+
+   while( g_stop == 0 )
+   {
+      int clientFd = ::accept4( m_fd, nullptr, nullptr, SOCK_CLOEXEC );
+      if( clientFd < 0 )
+      {
+         if( errno == EINTR || errno == ECONNABORTED )
+            continue;
+         ERROR_MESSAGE( "Unable to accept on socket \"" << m_socketName << "\": "
+                        << ::strerror( errno ) );
+         return EXIT_FAILURE;
+      }
+      serve( clientFd, defaults, run );
+      ::close( clientFd );
+   }
+   return EXIT_SUCCESS;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void Server::serve( int clientFd, const ARG_LIST_T& rDefaults, RUN_FUNCTION_T run )
+{
+   ARG_LIST_T args;
+   if( readRequest( clientFd, args ) )
+      return;
+
+   FILE* pOut = ::tmpfile();
+   FILE* pErr = ::tmpfile();
+   if( pOut == nullptr || pErr == nullptr )
+   {
+      ERROR_MESSAGE( "Unable to create temporary file: " << ::strerror( errno ) );
+      if( pOut != nullptr )
+         ::fclose( pOut );
+      if( pErr != nullptr )
+         ::fclose( pErr );
+      return;
+   }
+
+   std::cout.flush();
+   std::cerr.flush();
+
+   pid_t pid = ::fork();
+   if( pid == 0 )
+   { /*
+      * Child process: Makes the run like a call on the command line
+      * of the client.
+      */
+      ::signal( SIGTERM, SIG_DFL );
+      ::signal( SIGINT, SIG_DFL );
+      ::signal( SIGPIPE, SIG_DFL );
+      /*
+       * Own process group, so a timeout kills the preprocessor too.
+       */
+      ::setpgid( 0, 0 );
+      ::dup2( ::fileno( pOut ), STDOUT_FILENO );
+      ::dup2( ::fileno( pErr ), STDERR_FILENO );
+      if( isReserved( args ) )
+         ::exit( EXIT_FAILURE );
+      if( ::chdir( args.front().c_str() ) != 0 )
+      {
+         ERROR_MESSAGE( "Unable to change to directory \"" << args.front()
+                        << "\": " << ::strerror( errno ) );
+         ::exit( EXIT_FAILURE );
+      }
+      std::vector<char*> vpArgv;
+      for( const auto& rArg : rDefaults )
+         vpArgv.push_back( const_cast<char*>(rArg.c_str()) );
+      for( auto it = args.begin() + 1; it != args.end(); it++ )
+         vpArgv.push_back( const_cast<char*>(it->c_str()) );
+      vpArgv.push_back( nullptr );
+      ::exit( run( vpArgv.size() - 1, vpArgv.data() ) );
+   }
+
+   int exitStatus = EXIT_FAILURE;
+   if( pid < 0 )
+   {
+      ERROR_MESSAGE( "Unable to fork: " << ::strerror( errno ) );
+   }
+   else
+   {
+      int status;
+      if( wait( pid, status ) )
+      {
+         ::fseek( pErr, 0, SEEK_END );
+         if( g_stop == 0 )
+            ::fprintf( pErr, "ERROR: Request killed after %u seconds!\n",
+                       m_timeout );
+         else
+            ::fprintf( pErr, "ERROR: Request killed by stopping the server!\n" );
+         ::fflush( pErr );
+      }
+      if( WIFEXITED( status ) )
+         exitStatus = WEXITSTATUS( status );
+      else if( WIFSIGNALED( status ) )
+         exitStatus = 128 + WTERMSIG( status );
+   }
+
+   struct stat outStat;
+   struct stat errStat;
+   if( (::fstat( ::fileno( pOut ), &outStat ) == 0) &&
+       (::fstat( ::fileno( pErr ), &errStat ) == 0) )
+   {
+      char header[64];
+      int len = ::snprintf( header, sizeof( header ), "%d %lld %lld\n",
+                            exitStatus,
+                            static_cast<long long>(outStat.st_size),
+                            static_cast<long long>(errStat.st_size) );
+      if( !writeAll( clientFd, header, len ) &&
+          !sendFile( clientFd, ::fileno( pOut ) ) )
+         sendFile( clientFd, ::fileno( pErr ) );
+   }
+
+   ::fclose( pOut );
+   ::fclose( pErr );
+}
+
+/*!----------------------------------------------------------------------------
+ * The server's process remains responsive during the run of a request:
+ * The child becomes polled, so it can be killed together with its
+ * preprocessor when the time is over or when the server shall stop.
+ */
+bool Server::wait( pid_t pid, int& rStatus )
+{
+   struct timespec start;
+   ::clock_gettime( CLOCK_MONOTONIC, &start );
+   ::setpgid( pid, pid );
+   const long long timeout = m_timeout * 1000LL;
+   bool killed = false;
+   while( true )
+   {
+      pid_t ret = ::waitpid( pid, &rStatus, killed? 0 : WNOHANG );
+      if( ret == pid )
+         return killed;
+      if( (ret < 0) && (errno != EINTR) )
+      {
+         rStatus = EXIT_FAILURE << 8;
+         return killed;
+      }
+      if( killed )
+         continue;
+
+      struct timespec now;
+      ::clock_gettime( CLOCK_MONOTONIC, &now );
+      const long long elapsed = (now.tv_sec - start.tv_sec) * 1000LL
+                                + (now.tv_nsec - start.tv_nsec) / 1000000;
+      if( (g_stop != 0) || (elapsed >= timeout) )
+      {
+         ::kill( -pid, SIGKILL );
+         killed = true;
+         continue;
+      }
+      const struct timespec interval = { 0, 10 * 1000 * 1000 };
+      ::nanosleep( &interval, nullptr );
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ * The request becomes scanned like by the command line parser, so
+ * short options given together like "-vo" and arguments of options
+ * which look like a reserved option will recognized correctly.
+ */
+bool Server::isReserved( const ARG_LIST_T& rArgs )
+{
+   for( auto it = rArgs.begin() + 1; it != rArgs.end(); it++ )
+   {
+      const std::string& rArg = *it;
+      if( rArg == "--" )
+         return false;
+      if( (rArg.size() < 2) || (rArg[0] != '-') )
+         continue;
+
+      if( rArg[1] == '-' )
+      {
+         const std::size_t end = rArg.find( '=' );
+         const std::string name = rArg.substr( 2, end - 2 );
+         const CLOP::OPTION* pOption = findOption( name );
+         if( pOption == nullptr )
+            continue;
+         if( isReserved( pOption ) )
+            return true;
+         if( (pOption->m_hasArg == CLOP::OPTION::REQUIRED_ARG) &&
+             (end == std::string::npos) )
+            it++;
+      }
+      else
+      {
+         for( std::size_t i = 1; i < rArg.size(); i++ )
+         {
+            const CLOP::OPTION* pOption = findOption( rArg[i] );
+            if( pOption == nullptr )
+               break;
+            if( isReserved( pOption ) )
+               return true;
+            if( pOption->m_hasArg != CLOP::OPTION::REQUIRED_ARG )
+               continue;
+            if( i == rArg.size() - 1 )
+               it++;
+            break;
+         }
+      }
+      if( it == rArgs.end() )
+         break;
+   }
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool Server::isReserved( const CLOP::OPTION* pOption )
+{
+   for( const auto& pName : g_apReservedOptions )
+   {
+      if( pOption->m_longOpt == pName )
+      {
+         ERROR_MESSAGE( "Option \"--" << pName
+                        << "\" is not allowed in a request to the server!" );
+         return true;
+      }
+   }
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+const CLOP::OPTION* Server::findOption( const std::string& rLongName )
+{
+   for( const auto& pOption : m_rParser )
+   {
+      if( !rLongName.empty() && (pOption->m_longOpt == rLongName) )
+         return pOption;
+   }
+   return nullptr;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+const CLOP::OPTION* Server::findOption( char shortName )
+{
+   for( const auto& pOption : m_rParser )
+   {
+      if( pOption->m_shortOpt == shortName )
+         return pOption;
+   }
+   return nullptr;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool Server::readRequest( int fd, ARG_LIST_T& rArgs )
+{
+   std::string request;
+   char buffer[4096];
+   std::size_t begin = 0;
+
+   while( request.size() < MAX_REQUEST_SIZE )
+   {
+      ssize_t n = ::read( fd, buffer, sizeof( buffer ) );
+      if( n < 0 )
+      {
+         if( errno == EINTR )
+            continue;
+         return true;
+      }
+      if( n == 0 )
+         return true; // Request incomplete.
+      request.append( buffer, n );
+
+      std::size_t end;
+      while( (end = request.find( '\0', begin )) != std::string::npos )
+      {
+         if( end == begin )
+            return rArgs.empty(); // Empty argument terminates the request.
+         rArgs.push_back( request.substr( begin, end - begin ) );
+         begin = end + 1;
+      }
+   }
+   return true;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool Server::writeAll( int fd, const char* pData, std::size_t len )
+{
+   while( len > 0 )
+   {
+      ssize_t n = ::write( fd, pData, len );
+      if( n < 0 )
+      {
+         if( errno == EINTR )
+            continue;
+         return true;
+      }
+      pData += n;
+      len   -= n;
+   }
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool Server::sendFile( int clientFd, int fileFd )
+{
+   if( ::lseek( fileFd, 0, SEEK_SET ) != 0 )
+      return true;
+
+   char buffer[64 * 1024];
+   while( true )
+   {
+      ssize_t n = ::read( fileFd, buffer, sizeof( buffer ) );
+      if( n < 0 )
+      {
+         if( errno == EINTR )
+            continue;
+         return true;
+      }
+      if( n == 0 )
+         return false;
+      if( writeAll( clientFd, buffer, n ) )
+         return true;
+   }
+}
+
+//================================== EOF ======================================
@@ -0,0 +1,115 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!   @brief Module runs DocFsm as server on a Unix domain socket            */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_server.hpp                                                   */
+/*! @see     df_server.cpp                                                   */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#ifndef _DF_SERVER_HPP
+#define _DF_SERVER_HPP
+
+#ifndef __DOCFSM__
+ #include <string>
+ #include <vector>
+ #include <sys/types.h>
+ #include "df_commandline.hpp"
+#endif
+
+namespace DocFsm
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Server mode given by the option "--serve SOCKET".
+ *
+ * The server listens on the Unix domain socket SOCKET. Each request is
+ * handled by a forked copy of the already started and initialized process,
+ * so the costs of starting the program and the semantic of the options
+ * remain exactly as for a call on the command line.
+ *
+ * Request:  The working directory of the client followed by the arguments,
+ *           each terminated by '\\0' and the whole request terminated by an
+ *           empty argument.\n
+ *           The remaining options of the server's command line become
+ *           prepended to the arguments of each request.
+ *
+ * Response: A header line "<exit status> <stdout bytes> <stderr bytes>\\n"
+ *           followed by the standard output (the DOT-code) and the
+ *           error output of the run.
+ *
+ * The options of the operating modes and of the output-files like
+ * "--watch" or "--outdir" are reserved for the server's command line,
+ * a request containing one of them fails. A request which runs longer
+ * than the time given by "--serve-timeout" becomes killed.
+ */
+class Server
+{
+public:
+   /*!
+    * @brief Function which processes a command line, the
+    *        function main() of DocFsm.
+    */
+   using RUN_FUNCTION_T = int (*)( int argc, char** ppArgv );
+
+private:
+   using ARG_LIST_T = std::vector<std::string>;
+
+   class OptionServe: public CLOP::OPTION_V
+   {
+      Server*   m_pParent;
+   public:
+      OptionServe( Server* pParent );
+      int onGiven( CLOP::PARSER* poParser ) override;
+   };
+
+   class OptionTimeout: public CLOP::OPTION_V
+   {
+      Server*   m_pParent;
+   public:
+      OptionTimeout( Server* pParent );
+      int onGiven( CLOP::PARSER* poParser ) override;
+   };
+
+   OptionServe         m_oOptionServe;
+   OptionTimeout       m_oOptionTimeout;
+   CommandlineParser&  m_rParser;
+   std::string         m_socketName;
+   int                 m_fd;
+   unsigned int        m_timeout;
+
+public:
+   Server( CommandlineParser& rParser );
+   ~Server( void );
+
+   bool isActive( void ) const { return !m_socketName.empty(); }
+
+   /*!
+    * @brief Serves the requests until the signal SIGTERM or SIGINT
+    *        becomes received.
+    * @param argc    Number of arguments of the server's command line.
+    * @param ppArgv  Arguments of the server's command line.
+    * @param run     Function which processes each request.
+    * @return Exit status of the server.
+    */
+   int operator()( int argc, char** ppArgv, RUN_FUNCTION_T run );
+
+private:
+   bool listen( void );
+   void serve( int clientFd, const ARG_LIST_T& rDefaults, RUN_FUNCTION_T run );
+   bool wait( pid_t pid, int& rStatus );
+   bool isReserved( const ARG_LIST_T& rArgs );
+   static bool isReserved( const CLOP::OPTION* pOption );
+   const CLOP::OPTION* findOption( const std::string& rLongName );
+   const CLOP::OPTION* findOption( char shortName );
+   static bool readRequest( int fd, ARG_LIST_T& rArgs );
+   static bool writeAll( int fd, const char* pData, std::size_t len );
+   static bool sendFile( int clientFd, int fileFd );
+};
+
+} // End namespace DocFsm
+#endif // ifndef _DF_SERVER_HPP
+//================================== EOF ======================================
@@ -10,6 +10,9 @@
 /*! @date    17.12.2017                                                      */
 /*  Updates:                                                                 */
 /*****************************************************************************/
+#ifndef __DOCFSM__
+ #include <algorithm>
+#endif
 #include "df_docfsm.hpp"
 #include "df_state_collector.hpp"
 
@@ -27,8 +30,6 @@ StateCollector::GROUP::GROUP( std::string* pName )
 */
 StateCollector::GROUP::~GROUP( void )
 {
-   for( auto& pState : m_vpStates )
-      delete pState;
 }
 
 /*!----------------------------------------------------------------------------
@@ -43,40 +44,7 @@ bool StateCollector::GROUP::haveName( void )
 
 /*!----------------------------------------------------------------------------
 */
-bool StateCollector::GROUP::doesNotBelongToMe( std::string* pName )
-{
-   if( pName == m_pName )
-      return false;
-
-   if( (pName != nullptr) && (m_pName != nullptr) )
-      return *pName != *m_pName;
-
-   return true;
-}
-
-/*!----------------------------------------------------------------------------
-*/
-bool StateCollector::GROUP::doesContaining( StateGraph* pState )
-{
-   for( auto& i_pState : m_vpStates )
-      if( pState == i_pState )
-         return true;
-   return false;
-}
-
-/*!----------------------------------------------------------------------------
-*/
-void StateCollector::GROUP::addStatePtrIfNotAlreadyContaining( StateGraph* pState )
-{
-   for( auto& i_pState : m_vpStates )
-      if( pState == i_pState )
-         return;
-   m_vpStates.push_back( pState );
-}
-
-/*!----------------------------------------------------------------------------
-*/
-void StateCollector::GROUP::printStates( std::ostream& rOut, int tabs )
+void StateCollector::GROUP::printStates( DotWriter& rOut, int tabs )
 {
    for( auto& pStates : m_vpStates )
       pStates->printState( rOut, tabs );
@@ -84,7 +52,7 @@ void StateCollector::GROUP::printStates( std::ostream& rOut, int tabs )
 
 /*!----------------------------------------------------------------------------
 */
-void StateCollector::GROUP::printTransitions( std::ostream& rOut, int tabs )
+void StateCollector::GROUP::printTransitions( DotWriter& rOut, int tabs )
 {
    for( auto& pStates : m_vpStates )
       pStates->printTransitions( rOut, tabs );
@@ -122,33 +90,36 @@ int StateCollector::FSM::splitInGroups( void )
    assert( pBaseGroup->m_pName == nullptr );
    pBaseGroup->m_pName = pBaseGroup->m_vpStates.back()->findGroupName();
 
-
-   for( auto it_pState = pBaseGroup->m_vpStates.begin(); 
+   /*
+    * Index of the groups by their names, the group of the states without
+    * a group-name is held separately. So each state finds its group
+    * in constant time and the order of the groups remains the order of
+    * their first appearance.
+    */
+   std::unordered_map<std::string, GROUP*> groupIndex;
+   GROUP* pNoNameGroup = nullptr;
+   if( pBaseGroup->m_pName == nullptr )
+      pNoNameGroup = pBaseGroup;
+   else
+      groupIndex[*pBaseGroup->m_pName] = pBaseGroup;
+
+   for( auto it_pState = pBaseGroup->m_vpStates.begin();
              it_pState != pBaseGroup->m_vpStates.end();  )
    {
       std::string* pGroupName = (*it_pState)->findGroupName();
-      bool doesNotFit = pBaseGroup->doesNotBelongToMe( pGroupName );
-      if( !doesNotFit )
+      GROUP*& rpGroup = (pGroupName == nullptr)? pNoNameGroup :
+                                                 groupIndex[*pGroupName];
+      if( rpGroup == pBaseGroup )
       {
          it_pState++;
          continue;
       }
-      for( auto& pGroup : m_vpGroups )
+      if( rpGroup == nullptr )
       {
-         if( pGroup == pBaseGroup )
-            continue;
-         if( pGroup->doesNotBelongToMe( pGroupName ) )
-            continue;
-
-         pGroup->m_vpStates.push_back( *it_pState );
-         it_pState = pBaseGroup->m_vpStates.erase( it_pState );
-         doesNotFit = false;
+         rpGroup = new GROUP( pGroupName );
+         m_vpGroups.push_back( rpGroup );
       }
-      if( !doesNotFit )
-         continue;
-      GROUP* pGroup = new GROUP( pGroupName );
-      pGroup->m_vpStates.push_back( *it_pState );
-      m_vpGroups.push_back( pGroup );
+      rpGroup->m_vpStates.push_back( *it_pState );
       it_pState = pBaseGroup->m_vpStates.erase( it_pState );
    }
 
@@ -157,7 +128,7 @@ int StateCollector::FSM::splitInGroups( void )
 
 /*!----------------------------------------------------------------------------
 */
-void StateCollector::FSM::print( std::ostream& rOut, 
+void StateCollector::FSM::print( DotWriter& rOut, 
                                  const std::string& clusterName, int tabs )
 {
    int groupNum = 0;
@@ -165,17 +136,17 @@ void StateCollector::FSM::print( std::ostream& rOut,
    {
       if( pGroup->haveName() )
       {
-         printTabs( rOut, tabs );
+         rOut.tabs( tabs );
          rOut << clusterName << groupNum << " {\n";
          tabs++;
-         printTabs( rOut, tabs );
+         rOut.tabs( tabs );
          rOut << c_strLabel << pGroup->getName() << "\n";
       }
       pGroup->printStates( rOut, tabs );
       if( pGroup->haveName() )
       {
          tabs--;
-         printTabs( rOut, tabs );
+         rOut.tabs( tabs );
          rOut << "}\n";
          groupNum++;
       }
@@ -200,9 +171,6 @@ StateCollector::MODULE::~MODULE( void )
 {
    for( auto& pFsm : m_vpFsm )
       delete pFsm;
-
-   for( auto& pAttribute : m_vpAttributes )
-      delete pAttribute;
 }
 
 /*!----------------------------------------------------------------------------
@@ -227,50 +195,83 @@ int StateCollector::MODULE::isATarget( const StateGraph* pStateGraph )
 }
 #endif
 /*!----------------------------------------------------------------------------
-*/
+ * Each set of states which are connected by transitions regardless of their
+ * direction becomes a FSM of its own. The sets are found by union-find over
+ * the positions of the states in the state list, so the costs are linear
+ * in the number of states and transitions and there is no recursion.\n
+ * The FSMs are numbered in the order of their first state in the list,
+ * the first one remains in the origin FSM.
+ */
 int StateCollector::MODULE::splitInClusters( void )
 {
    FSM* pOriginFsm = m_vpFsm.back();
-   int maxFsmNumber = 0;
-   bool inFsm;
-   do
+   STATES& rStates = pOriginFsm->getStateList();
+
+   std::unordered_map<const StateGraph*, std::size_t> position;
+   position.reserve( rStates.size() );
+   std::vector<std::size_t> parent;
+   parent.reserve( rStates.size() );
+   for( const auto& pState : rStates )
    {
-      maxFsmNumber++;
-      for( auto& i : pOriginFsm->getStateList() )
+      position[pState] = parent.size();
+      parent.push_back( parent.size() );
+   }
+
+   const auto findRoot = [&parent]( std::size_t i ) -> std::size_t
+   {
+      while( parent[i] != i )
       {
-         if( i->getFsmNumber() != 0 )
-            continue;
-         i->setFsm( maxFsmNumber );
-         break;
+         parent[i] = parent[parent[i]];
+         i = parent[i];
       }
-      inFsm = true;
-      for( auto& i : pOriginFsm->getStateList() )
+      return i;
+   };
+
+   std::size_t i = 0;
+   for( const auto& pState : rStates )
+   {
+      for( const auto& pTransition : pState->getTransitionList() )
       {
-         i->obtainFsmNumberIfEqual( maxFsmNumber );
-         if( i->getFsmNumber() == 0 )
-            inFsm = false;
+         /*
+          * Targets in other modules doesn't belong to the clusters of
+          * this module.
+          */
+         const auto it = position.find( pTransition->getTargetState() );
+         if( it == position.end() )
+            continue;
+         const std::size_t a = findRoot( i );
+         const std::size_t b = findRoot( it->second );
+         if( a != b )
+            parent[std::max( a, b )] = std::min( a, b );
       }
+      i++;
+   }
+
+   std::vector<int> fsmNumber( parent.size(), 0 );
+   int maxFsmNumber = 0;
+   i = 0;
+   for( const auto& pState : rStates )
+   {
+      const std::size_t root = findRoot( i++ );
+      if( fsmNumber[root] == 0 )
+         fsmNumber[root] = ++maxFsmNumber;
+      pState->setFsm( fsmNumber[root] );
    }
-   while( !inFsm );
 
+   const std::size_t firstNewFsm = m_vpFsm.size();
    for( int fsm = 2; fsm <= maxFsmNumber; fsm++ )
+      m_vpFsm.push_back( new FSM );
+
+   for( auto it = rStates.begin(); it != rStates.end(); )
    {
-      FSM* pNewFsm = nullptr;
-      for( auto it = pOriginFsm->getStateList().begin(); it != pOriginFsm->getStateList().end(); )
+      const int fsm = (*it)->getFsmNumber();
+      if( fsm < 2 )
       {
-         if( ((*it)->getFsmNumber() == fsm) )
-         {
-            if( pNewFsm == nullptr )
-            {
-               pNewFsm = new FSM;
-               m_vpFsm.push_back( pNewFsm );
-            }
-            pNewFsm->getStateList().push_back( *it );
-            it = pOriginFsm->getStateList().erase( it );
-         }
-         else
-            it++;
+         it++;
+         continue;
       }
+      m_vpFsm[firstNewFsm + fsm - 2]->getStateList().push_back( *it );
+      it = rStates.erase( it );
    }
 
    return maxFsmNumber;
@@ -306,7 +307,6 @@ int StateCollector::SetGraphAttributes::onGiven( CLOP::PARSER* poParser )
 {
    if( m_pParent->addGraphAttribute( poParser->getOptArg() ))
    {
-      ::exit( EXIT_FAILURE );
       return -1;
    }
    return 0;
@@ -333,7 +333,6 @@ int StateCollector::SetNodeAttributes::onGiven( CLOP::PARSER* poParser )
 {
    if( m_pParent->addNodeAttribute( poParser->getOptArg() ))
    {
-      ::exit( EXIT_FAILURE );
       return -1;
    }
    return 0;
@@ -359,7 +358,6 @@ int StateCollector::SetEdgeAttributes::onGiven( CLOP::PARSER* poParser )
 {
    if( m_pParent->addEdgeAttribute( poParser->getOptArg() ))
    {
-      ::exit( EXIT_FAILURE );
       return -1;
    }
    return 0;
@@ -498,7 +496,7 @@ const std::string StateCollector::c_strLabel = "label = ";
 /*!----------------------------------------------------------------------------
 */
 StateCollector::StateCollector( SourceBrowser& rSourceBrowser, 
-                                KeywordPool& rKeywords,
+                                const KeywordPool& rKeywords,
                                 CommandlineParser& rCommandLine
                               )
    :KeywordInterpreter( rSourceBrowser )
@@ -519,7 +517,10 @@ StateCollector::StateCollector( SourceBrowser& rSourceBrowser,
    ,m_noTransitions( false )
    ,m_noTransitionLabels( false )
    ,m_generateTransitionTooltips( false )
+   ,m_foreignAccess( false )
    ,m_entryCount( 0 )
+   ,m_currentModule( 0 )
+   ,m_oAttributeReader( m_oArena )
 {
    rCommandLine( m_setGraphAttributes )
                ( m_setNodeAttributes )
@@ -534,21 +535,83 @@ StateCollector::StateCollector( SourceBrowser& rSourceBrowser,
    assert( m_pLabelAttribute != nullptr );
 }
 
+/*!----------------------------------------------------------------------------
+ * The options become not registered, all settings are taken from rOrigin.
+ */
+StateCollector::StateCollector( const StateCollector& rOrigin,
+                                SourceBrowser& rSourceBrowser )
+   :KeywordInterpreter( rSourceBrowser )
+   ,m_setGraphAttributes( this )
+   ,m_setNodeAttributes( this )
+   ,m_setEdgeAttributes( this )
+   ,m_setSingleGraph( this )
+   ,m_setNoStateGroups( this )
+   ,m_setNoFsmGroups( this )
+   ,m_setNoTransitions( this )
+   ,m_setNoTransitionLabel( this )
+   ,m_setTransitionToolTip( this )
+   ,m_vpGraphAttributes( rOrigin.m_vpGraphAttributes )
+   ,m_vpNodeAttributes( rOrigin.m_vpNodeAttributes )
+   ,m_vpEdgeAttributes( rOrigin.m_vpEdgeAttributes )
+   ,m_rKeywords( rOrigin.m_rKeywords )
+   ,m_parseArgument( false )
+   ,m_isSingle( rOrigin.m_isSingle )
+   ,m_noStateGroups( rOrigin.m_noStateGroups )
+   ,m_noFsmGroups( rOrigin.m_noFsmGroups )
+   ,m_noTransitions( rOrigin.m_noTransitions )
+   ,m_noTransitionLabels( rOrigin.m_noTransitionLabels )
+   ,m_generateTransitionTooltips( rOrigin.m_generateTransitionTooltips )
+   ,m_foreignAccess( false )
+   ,m_entryCount( 0 )
+   ,m_currentModule( 0 )
+   ,m_oAttributeReader( m_oArena )
+   ,m_pLabelAttribute( rOrigin.m_pLabelAttribute )
+{
+}
+
 /*!----------------------------------------------------------------------------
 */
 StateCollector::~StateCollector( void )
 {
-   for( auto& pGerphAttribute : m_vpGraphAttributes )
-      delete pGerphAttribute;
-
-   for( auto& pNodeAttribute : m_vpNodeAttributes )
-      delete pNodeAttribute;
-
-   for( auto& pEdgeAttribure : m_vpEdgeAttributes )
-      delete pEdgeAttribure;
+   for( auto& pModule : m_vpModules )
+      delete pModule;
+}
 
+/*!----------------------------------------------------------------------------
+*/
+void StateCollector::clear( void )
+{
    for( auto& pModule : m_vpModules )
       delete pModule;
+   m_vpModules.clear();
+   m_stateIndex.clear();
+   m_oArena.clear();
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void StateCollector::getAllStates( STATE_LIST_T& rStates ) const
+{
+   for( const auto& pModule : m_vpModules )
+      for( const auto& pFsm : pModule->m_vpFsm )
+         for( const auto& pGroup : pFsm->m_vpGroups )
+            rStates.insert( rStates.end(), pGroup->m_vpStates.begin(),
+                                           pGroup->m_vpStates.end() );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void StateCollector::warnNoKeywords( const std::string& rName )
+{
+   std::stringbuf str;
+   std::ostream   outStream(&str);
+   outStream << "\"";
+   m_rKeywords.listTransitionKeywords( outStream );
+   outStream << "\" and/or \"";
+   m_rKeywords.listDeclareKeywords( outStream );
+   outStream << "\"";
+   WARNING_MESSAGE( "No keywords " << str.str() << " "
+                    "in file: \"" << rName << "\" found!" );
 }
 
 /*!----------------------------------------------------------------------------
@@ -556,8 +619,17 @@ StateCollector::~StateCollector( void )
 bool StateCollector::collect( const std::string& rName )
 {
    m_entryCount = 0;
+   m_foreignAccess = false;
+   m_currentModule = m_vpModules.size();
    m_vpModules.push_back( new MODULE( rName ) );
 
+   /*
+    * The source-code becomes tokenized only once here, all following
+    * passes including them of the TransitionFinder replaying the tokens.
+    */
+   if( getSourceBrowser().scan() )
+      return true;
+
    if( browse(COLLECT_TRANSITIONS) )
       return true;
 
@@ -568,15 +640,7 @@ bool StateCollector::collect( const std::string& rName )
    {
       delete m_vpModules.back();
       m_vpModules.pop_back();
-      std::stringbuf str;
-      std::ostream   outStream(&str);
-      outStream << "\"";
-      m_rKeywords.listTransitionKeywords( outStream );
-      outStream << "\" and/or \"";
-      m_rKeywords.listDeclareKeywords( outStream );
-      outStream << "\"";
-      WARNING_MESSAGE( "No keywords " << str.str() << " "
-                       "in file: \"" << rName << "\" found!" );
+      warnNoKeywords( rName );
       return false;
    }
 
@@ -591,6 +655,7 @@ bool StateCollector::collect( const std::string& rName )
 */
 void StateCollector::onRecognized( std::string word )
 {
+   countWord();
    if( m_parseArgument )
    {
       StateGraph* poTargetStade = find( word );
@@ -650,7 +715,7 @@ bool StateCollector::prepareEntryPoint( StateGraph* poTargetStade )
    if( poStade == nullptr )
       return true;
    m_entryCount++;
-   TransitionGraph* pTransitionGraph = new TransitionGraph( poTargetStade );
+   TransitionGraph* pTransitionGraph = m_oArena.create<TransitionGraph>( poTargetStade );
    poStade->addTransition( pTransitionGraph );
 
 #ifdef CONFIG_POINT_AS_ENTRY_EXIT_STATE
@@ -681,14 +746,15 @@ bool StateCollector::readStateAttributes( StateGraph* poTargetStade )
 */
 StateGraph* StateCollector::find( const std::string& name )
 {
-   for( const auto& pModul: m_vpModules )
-      for( const auto& pFsm: pModul->m_vpFsm )
-         for( const auto& pGroup: pFsm->m_vpGroups )
-            for( const auto& pState: pGroup->m_vpStates )
-               if( pState->getName() == name )
-                  return pState;
+   m_oCounters.m_finds++;
+   const auto it = m_stateIndex.find( name );
+   if( it == m_stateIndex.end() )
+      return nullptr;
 
-   return nullptr;
+   assert( it->second.m_pState->getName() == name );
+   if( it->second.m_module != m_currentModule )
+      m_foreignAccess = true;
+   return it->second.m_pState;
 }
 
 /*!----------------------------------------------------------------------------
@@ -697,7 +763,7 @@ bool StateCollector::addGlobalAttribute( const DotKeywords::DOT_ATTR_LIST_T& rDo
                                          ATTR_LIST_T& rAttr,
                                          const std::string& rStr )
 {
-   const DotKeywords::DOT_ATTR_ITEM_T* pAttrItem;
+   const DotKeywords::DOT_ATTR_ITEM_T* pAttrItem = nullptr;
    std::string temp;
    bool isArgument = false;
 
@@ -728,7 +794,8 @@ bool StateCollector::addGlobalAttribute( const DotKeywords::DOT_ATTR_LIST_T& rDo
       return true;
    }
    assert( pAttrItem != nullptr );
-   rAttr.push_back( new ATTR_T( *pAttrItem, new std::string( temp )));
+   rAttr.push_back( m_oGlobalArena.create<ATTR_T>( *pAttrItem,
+                                          m_oGlobalArena.create<std::string>( temp )));
    return false;
 }
 
@@ -736,7 +803,11 @@ bool StateCollector::addGlobalAttribute( const DotKeywords::DOT_ATTR_LIST_T& rDo
 */
 StateGraph* StateCollector::addIfNotAlreadyDone( const std::string& rWord )
 {
-   if( find( rWord ) != nullptr )
+   /*
+    * Only the existence of the name is checked here, the found state will
+    * not touched. Therefore it's not a foreign access.
+    */
+   if( m_stateIndex.count( rWord ) != 0 )
       return nullptr;
 
    return add( rWord );
@@ -746,9 +817,13 @@ StateGraph* StateCollector::addIfNotAlreadyDone( const std::string& rWord )
 */
 StateGraph* StateCollector::add( const std::string& rWord )
 {
-   StateGraph* poStade = new StateGraph( this, rWord );
-   if( poStade != nullptr );
-      get().push_back( poStade );
+   assert( m_stateIndex.count( rWord ) == 0 );
+   StateGraph* poStade = m_oArena.create<StateGraph>( this, rWord );
+   get().push_back( poStade );
+   const std::size_t module = m_vpModules.size() - 1;
+   if( module != m_currentModule )
+      m_foreignAccess = true;
+   m_stateIndex[rWord] = { poStade, module };
    return poStade;
 }
 
@@ -760,7 +835,8 @@ void StateCollector::setGlobalAttributesIfEmpty( void )
    {
       const DotKeywords::DOT_ATTR_ITEM_T* pAttr = DotKeywords::findNodeWord( "shape" );
       assert( pAttr != nullptr );
-      m_vpNodeAttributes.push_back( new ATTR_T( *pAttr, new std::string("Mrecord") ) );
+      m_vpNodeAttributes.push_back( m_oGlobalArena.create<ATTR_T>( *pAttr,
+                                       m_oGlobalArena.create<std::string>( "Mrecord" )));
    }
 }
 
@@ -835,15 +911,27 @@ void StateCollector::generateTooltipFromLabel( void )
 
 /*!----------------------------------------------------------------------------
 */
-void StateCollector::printTabs( std::ostream& rOut, int tabs )
+void StateCollector::countModel( std::size_t firstModule,
+                                 Statistics::COUNTERS_T& rCounters ) const
 {
-   for( int i = 0; i < tabs; i++ )
-      rOut << '\t';
+   for( std::size_t i = firstModule; i < m_vpModules.size(); i++ )
+      for( const auto& pFsm: m_vpModules[i]->m_vpFsm )
+         for( const auto& pGroup: pFsm->m_vpGroups )
+            for( const auto& pState: pGroup->m_vpStates )
+            {
+               rCounters.m_states++;
+               rCounters.m_attributes += pState->getAttrList().size();
+               for( const auto& pTransition: pState->getTransitionList() )
+               {
+                  rCounters.m_transitions++;
+                  rCounters.m_attributes += pTransition->getAttrList().size();
+               }
+            }
 }
 
 /*!----------------------------------------------------------------------------
 */
-void StateCollector::print( std::ostream& rOut )
+void StateCollector::print( DotWriter& rOut )
 {
    if( m_vpModules.size() == 0 )
       return;
@@ -889,13 +977,13 @@ void StateCollector::print( std::ostream& rOut )
 
          if( pModule->m_vpFsm.size() > 1 )
          {
-            printTabs( rOut, tabs );
+            rOut.tabs( tabs );
             clusterName += std::to_string( moduleClusterNumber );
             clusterName += '_';
             clusterName += std::to_string( fsmClusterNumber );
             rOut << clusterName << " {\n";
             tabs++;
-            printTabs( rOut, tabs );
+            rOut.tabs( tabs );
             rOut << c_strLabel << "\"FSM: " << fsmClusterNumber << "\";\n";
          }
 
@@ -904,7 +992,7 @@ void StateCollector::print( std::ostream& rOut )
          if( pModule->m_vpFsm.size() > 1 )
          {
             tabs--;
-            printTabs( rOut, tabs );
+            rOut.tabs( tabs );
             rOut << "}\n";
          }
          fsmClusterNumber++;
@@ -915,7 +1003,7 @@ void StateCollector::print( std::ostream& rOut )
 
       moduleClusterNumber++;
    }
-   rOut << "}" << std::endl;
+   rOut << "}\n";
 }
 
 //================================== EOF ======================================
@@ -15,11 +15,13 @@
 
 #ifndef __DOCFSM__
  #include <list>
+ #include <unordered_map>
  #include "df_keyword.hpp"
  #include "df_keyword_pool.hpp"
  #include "df_dotgenerator.hpp"
  #include "df_attribute_reader.hpp"
  #include "df_dot_keywords.hpp"
+ #include "df_statistics.hpp"
 #endif
 
 namespace DocFsm
@@ -28,6 +30,8 @@ namespace DocFsm
 ///////////////////////////////////////////////////////////////////////////////
 class StateCollector: public KeywordInterpreter
 {
+   friend class ModelCache;
+
    static const std::string c_strLabel;
 
    using STATES = std::list <StateGraph*>;
@@ -39,17 +43,14 @@ class StateCollector: public KeywordInterpreter
 
       GROUP( std::string* pName = nullptr );
       ~GROUP( void );
-      void printStates( std::ostream& rOut, int tabs );
-      void printTransitions( std::ostream& rOut, int tabs );
+      void printStates( DotWriter& rOut, int tabs );
+      void printTransitions( DotWriter& rOut, int tabs );
       bool haveName( void );
       const std::string& getName( void ) const
       {
          assert( m_pName != nullptr );
          return *m_pName;
       }
-      bool doesNotBelongToMe( std::string* pName );
-      bool doesContaining( StateGraph* );
-      void addStatePtrIfNotAlreadyContaining( StateGraph* );
    };
 
    using GROUPS = std::list <GROUP*>;
@@ -65,7 +66,7 @@ class StateCollector: public KeywordInterpreter
          return m_vpGroups.back()->m_vpStates;
       }
       int splitInGroups( void );
-      void print( std::ostream& rOut, const std::string& clusterName, int tabs );
+      void print( DotWriter& rOut, const std::string& clusterName, int tabs );
    };
 
    using FSM_LIST = std::vector<FSM*>;
@@ -84,6 +85,23 @@ class StateCollector: public KeywordInterpreter
 
    using MODULE_V = std::vector <MODULE*>;
 
+   /*!
+    * @brief Index of all states of all modules by its names.
+    *
+    * The state names are unique over all modules, because a new state
+    * becomes added only when it was not found. Splitting in clusters and
+    * groups moves only the pointers, so the index remains valid.
+    * Beside the state the index of the module which owns the state
+    * is stored.
+    */
+   struct STATE_REF_T
+   {
+      StateGraph*  m_pState;
+      std::size_t  m_module;
+   };
+
+   using STATE_INDEX_T = std::unordered_map<std::string, STATE_REF_T>;
+
    enum TO_COLLECT_T
    {
       COLLECT_TRANSITIONS,
@@ -175,7 +193,7 @@ class StateCollector: public KeywordInterpreter
    ATTR_LIST_T                         m_vpNodeAttributes;
    ATTR_LIST_T                         m_vpEdgeAttributes;
    TO_COLLECT_T                        m_toCollect;
-   KeywordPool&                        m_rKeywords;
+   const KeywordPool&                  m_rKeywords;
    bool                                m_parseArgument;
    bool                                m_isSingle;
    bool                                m_noStateGroups;
@@ -183,13 +201,31 @@ class StateCollector: public KeywordInterpreter
    bool                                m_noTransitions;
    bool                                m_noTransitionLabels;
    bool                                m_generateTransitionTooltips;
+   bool                                m_foreignAccess;
    int                                 m_entryCount;
+   std::size_t                         m_currentModule;
+   Statistics::COUNTERS_T              m_oCounters;
+   Arena                               m_oArena;
+   Arena                               m_oGlobalArena;
    MODULE_V                            m_vpModules;
+   STATE_INDEX_T                       m_stateIndex;
    AttributeReader                     m_oAttributeReader;
    const DotKeywords::DOT_ATTR_ITEM_T* m_pLabelAttribute;
 
 public:
-   StateCollector( SourceBrowser&, KeywordPool&, CommandlineParser& );
+   using STATE_LIST_T = std::vector<StateGraph*>;
+
+   StateCollector( SourceBrowser&, const KeywordPool&, CommandlineParser& );
+
+   /*!
+    * @brief Further collector with the configuration given by the options
+    *        of rOrigin, but with an own model and parse state.
+    *
+    * Necessary for extracting concurrently in several threads. The global
+    * attributes given by options are shared with rOrigin, so rOrigin has to
+    * exist as long as this object and must not collect or print anymore.
+    */
+   StateCollector( const StateCollector& rOrigin, SourceBrowser& );
    virtual ~StateCollector( void );
 
    bool collect( const std::string& rName );
@@ -224,13 +260,39 @@ public:
    void splitInGroups( void );
    void generateTooltipFromLabel( void );
 
-   void print( std::ostream& rOut );
+   void print( DotWriter& rOut );
 
-   KeywordPool& getKeywords( void )
+   /*!
+    * @brief Removes all modules and releases their states, transitions
+    *        and attributes, so the following file starts with an empty
+    *        model. The global attributes given by options remain.
+    */
+   void clear( void );
+
+   /*!
+    * @brief Appends all states of all modules to rStates, in the order
+    *        of the modules, FSMs and groups.
+    */
+   void getAllStates( STATE_LIST_T& rStates ) const;
+
+   /*!
+    * @brief Warns that the given file doesn't contain any state.
+    */
+   void warnNoKeywords( const std::string& rName );
+
+   const KeywordPool& getKeywords( void ) const
    {
       return m_rKeywords;
    }
 
+   /*!
+    * @brief Arena which owns all states, transitions and attributes.
+    */
+   Arena& getArena( void )
+   {
+      return m_oArena;
+   }
+
    AttributeReader& getAttributeReader( void )
    {
       return m_oAttributeReader;
@@ -249,13 +311,40 @@ public:
 
    bool noTransitions( void ) const { return m_noTransitions; }
 
+   /*!
+    * @brief Counters of the recognized words and of the calls of find(),
+    *        summed up over all files.
+    */
+   const Statistics::COUNTERS_T& getCounters( void ) const
+   {
+      return m_oCounters;
+   }
+
+   void countWord( void ) { m_oCounters.m_words++; }
+
+   std::size_t getModuleCount( void ) const { return m_vpModules.size(); }
+
+   /*!
+    * @brief Adds the number of states, transitions and attributes of the
+    *        modules beginning at the given index to rCounters.
+    */
+   void countModel( std::size_t firstModule,
+                    Statistics::COUNTERS_T& rCounters ) const;
+
+   /*!
+    * @brief Returns true when since the last call of collect() a state of
+    *        a module of a previous file was found or added.
+    *
+    * In this case the result of the current file depends on the
+    * previous files.
+    */
+   bool hasForeignAccess( void ) const { return m_foreignAccess; }
+
    StateGraph* addIfNotAlreadyDone( const std::string& rWord );
 
    static std::string baseFileName( const std::string& rStr );
    static std::string stripFileName( const std::string& rStr );
 
-   static void printTabs( std::ostream& rOut, int tabs );
-
    bool noTransitionLabels( void ) const
    {
       return m_noTransitionLabels;
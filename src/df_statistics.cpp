@@ -0,0 +1,442 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!   @brief Module records the times and counters of the processing stages  */
+/*!          of DocFsm for each source-file.                                 */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_statistics.cpp                                               */
+/*! @see     df_statistics.hpp                                               */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#ifndef __DOCFSM__
+ #include <stdlib.h>
+ #include <stdio.h>
+ #include <unistd.h>
+ #include <sys/stat.h>
+ #include <fstream>
+ #include <iomanip>
+#endif
+#include "df_docfsm.hpp"
+#include "df_state_collector.hpp"
+#include "df_statistics.hpp"
+
+using namespace DocFsm;
+
+/*!
+ * @brief Names of the per-file stages in the output.
+ */
+static const char* const c_cppName         = "cpp";
+static const char* const c_preparseName    = "preparse";
+static const char* const c_cacheName       = "cache";
+static const char* const c_collectName     = "collect";
+static const char* const c_transitionsName = "transitions";
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+void Statistics::COUNTERS_T::add( const COUNTERS_T& rCounters )
+{
+   m_words       += rCounters.m_words;
+   m_finds       += rCounters.m_finds;
+   m_states      += rCounters.m_states;
+   m_transitions += rCounters.m_transitions;
+   m_attributes  += rCounters.m_attributes;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+Statistics::FILE_T::FILE_T( const std::string& rName )
+   :m_name( rName )
+   ,m_cached( false )
+   ,m_sourceBytes( 0 )
+   ,m_cache( StopWatch::THREAD )
+   ,m_collect( StopWatch::THREAD )
+   ,m_transitions( StopWatch::THREAD )
+   ,m_firstModule( 0 )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+Statistics::OptionStats::OptionStats( Statistics* pParent )
+   :m_pParent( pParent )
+{
+#ifndef CONFIG_CLOP_NO_OPTIONAL_ARG
+   m_hasArg   = OPTIONAL_ARG;
+#else
+   m_hasArg   = NO_ARG;
+#endif
+   m_shortOpt = '\0';
+   m_longOpt  = "stats";
+   m_helpText = "Prints the wall-clock and CPU times of the processing stages\n"
+                "and the counts of bytes, recognized words, state look-ups,\n"
+                "states, transitions and attributes of each source-file\n"
+                "and in total to stderr."
+#ifndef CONFIG_CLOP_NO_OPTIONAL_ARG
+                "\nWith the optional PARAM \"json\" in JSON-format.\n"
+                "E.g.: --stats=json"
+#endif
+                ;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int Statistics::OptionStats::onGiven( CLOP::PARSER* poParser )
+{
+#ifndef CONFIG_CLOP_NO_OPTIONAL_ARG
+   const std::string& rFormat = poParser->getOptArg();
+   if( rFormat == "json" )
+   {
+      m_pParent->m_format = JSON;
+      return 0;
+   }
+   if( !rFormat.empty() && (rFormat != "text") )
+   {
+      ERROR_MESSAGE( "Unknown statistics format: \"" << rFormat << "\"" );
+      return -1;
+   }
+#endif
+   if( m_pParent->m_format == NONE )
+      m_pParent->m_format = TEXT;
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+Statistics::OptionStatsFile::OptionStatsFile( Statistics* pParent )
+   :m_pParent( pParent )
+{
+   m_hasArg   = REQUIRED_ARG;
+   m_shortOpt = '\0';
+   m_longOpt  = "stats-file";
+   m_helpText = "Like option \"--stats\" but writes the statistics in the\n"
+                "file PARAM instead of stderr. If PARAM ends with \".json\"\n"
+                "so the JSON-format will used.\n"
+                "E.g.: --stats-file docfsm_stats.json";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int Statistics::OptionStatsFile::onGiven( CLOP::PARSER* poParser )
+{
+   const std::string& rFileName = poParser->getOptArg();
+   if( rFileName.empty() )
+   {
+      ERROR_MESSAGE( "Missing file name for statistics!" );
+      return -1;
+   }
+   m_pParent->m_fileName = rFileName;
+
+   static const std::string jsonExtension = ".json";
+   if( (rFileName.size() > jsonExtension.size()) &&
+       (rFileName.compare( rFileName.size() - jsonExtension.size(),
+                           jsonExtension.size(), jsonExtension ) == 0) )
+      m_pParent->m_format = JSON;
+   else if( m_pParent->m_format == NONE )
+      m_pParent->m_format = TEXT;
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+Statistics::Statistics( CommandlineParser& rParser )
+   :m_oOptionStats( this )
+   ,m_oOptionStatsFile( this )
+   ,m_format( NONE )
+{
+   rParser( m_oOptionStats )( m_oOptionStatsFile );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+Statistics::FILE_T& Statistics::beginFile( const std::string& rFileName,
+                                           const StateCollector& rCollector )
+{
+   /*
+    * Without output only the record of the current file is needed.
+    */
+   if( !isActive() )
+      m_vFiles.clear();
+
+   m_vFiles.push_back( FILE_T( rFileName ) );
+   FILE_T& rFile = m_vFiles.back();
+
+   rFile.m_counters.m_words = rCollector.getCounters().m_words;
+   rFile.m_counters.m_finds = rCollector.getCounters().m_finds;
+   rFile.m_firstModule      = rCollector.getModuleCount();
+
+   if( isActive() )
+   {
+      struct stat status;
+      if( ::stat( rFileName.c_str(), &status ) == 0 )
+         rFile.m_sourceBytes = status.st_size;
+   }
+   return rFile;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void Statistics::endFile( const StateCollector& rCollector )
+{
+   assert( !m_vFiles.empty() );
+   FILE_T& rFile = m_vFiles.back();
+
+   rFile.m_counters.m_words = rCollector.getCounters().m_words - rFile.m_counters.m_words;
+   rFile.m_counters.m_finds = rCollector.getCounters().m_finds - rFile.m_counters.m_finds;
+   if( isActive() )
+      rCollector.countModel( rFile.m_firstModule, rFile.m_counters );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool Statistics::write( void )
+{
+   if( !isActive() )
+      return false;
+
+   m_run.stop();
+
+   if( m_fileName.empty() )
+   {
+      if( m_format == JSON )
+         writeJson( std::cerr );
+      else
+         writeText( std::cerr );
+      return false;
+   }
+
+   /*
+    * Written to a temporary file which becomes renamed at the end, so a
+    * reader never sees an incomplete file.
+    */
+   const std::string tempName = m_fileName + ".tmp";
+   std::ofstream out( tempName );
+   if( !out.is_open() )
+   {
+      ERROR_MESSAGE( "Unable to open statistics file \"" << tempName << "\"!" );
+      return true;
+   }
+   if( m_format == JSON )
+      writeJson( out );
+   else
+      writeText( out );
+   out.close();
+
+   if( out.fail() || (::rename( tempName.c_str(), m_fileName.c_str() ) != 0) )
+   {
+      ERROR_MESSAGE( "Unable to write statistics file \"" << m_fileName << "\"!" );
+      ::unlink( tempName.c_str() );
+      return true;
+   }
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+static void writeTime( std::ostream& rOut, const char* pName,
+                       const StopWatch& rWatch )
+{
+   rOut << std::left << std::setw( 14 ) << pName
+        << std::right << std::setw( 14 ) << rWatch.getWall() * 1000.0
+        << std::setw( 14 ) << rWatch.getCpu() * 1000.0 << "\n";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+static void writeCounters( std::ostream& rOut,
+                           const Statistics::COUNTERS_T& rCounters )
+{
+   rOut << "words:              " << rCounters.m_words << "\n"
+           "find() calls:       " << rCounters.m_finds << "\n"
+           "states:             " << rCounters.m_states << "\n"
+           "transitions:        " << rCounters.m_transitions << "\n"
+           "attributes:         " << rCounters.m_attributes << "\n";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void Statistics::writeText( std::ostream& rOut )
+{
+   StopWatch cpp, preparse, cache, collect, transitions;
+   COUNTERS_T counters;
+   std::size_t sourceBytes = 0;
+   std::size_t preprocessedBytes = 0;
+   std::size_t preparsedBytes = 0;
+   std::size_t cached = 0;
+   std::size_t prefiltered = 0;
+
+   rOut << std::fixed << std::setprecision( 3 );
+   for( const auto& rFile : m_vFiles )
+   {
+      rOut << "file:               " << rFile.m_name
+           << (rFile.m_cached? " (cached)" : "")
+           << (rFile.m_preprocess.m_prefiltered? " (no keywords)\n" : "\n")
+           << "source bytes:       " << rFile.m_sourceBytes << "\n"
+              "preprocessed bytes: " << rFile.m_preprocess.m_preprocessedBytes << "\n"
+              "preparsed bytes:    " << rFile.m_preprocess.m_preparsedBytes << "\n";
+      writeCounters( rOut, rFile.m_counters );
+      rOut << std::left << std::setw( 14 ) << "stage"
+           << std::right << std::setw( 14 ) << "wall [ms]"
+           << std::setw( 14 ) << "CPU [ms]" << "\n";
+      writeTime( rOut, c_cppName, rFile.m_preprocess.m_cpp );
+      writeTime( rOut, c_preparseName, rFile.m_preprocess.m_preparse );
+      writeTime( rOut, c_cacheName, rFile.m_cache );
+      writeTime( rOut, c_collectName, rFile.m_collect );
+      writeTime( rOut, c_transitionsName, rFile.m_transitions );
+      rOut << "\n";
+
+      cpp.add( rFile.m_preprocess.m_cpp );
+      preparse.add( rFile.m_preprocess.m_preparse );
+      cache.add( rFile.m_cache );
+      collect.add( rFile.m_collect );
+      transitions.add( rFile.m_transitions );
+      counters.add( rFile.m_counters );
+      sourceBytes       += rFile.m_sourceBytes;
+      preprocessedBytes += rFile.m_preprocess.m_preprocessedBytes;
+      preparsedBytes    += rFile.m_preprocess.m_preparsedBytes;
+      if( rFile.m_cached )
+         cached++;
+      if( rFile.m_preprocess.m_prefiltered )
+         prefiltered++;
+   }
+
+   rOut << "total\n"
+           "files:              " << m_vFiles.size() << "\n"
+           "cached files:       " << cached << "\n"
+           "prefiltered files:  " << prefiltered << "\n"
+           "source bytes:       " << sourceBytes << "\n"
+           "preprocessed bytes: " << preprocessedBytes << "\n"
+           "preparsed bytes:    " << preparsedBytes << "\n";
+   writeCounters( rOut, counters );
+   rOut << std::left << std::setw( 14 ) << "stage"
+        << std::right << std::setw( 14 ) << "wall [ms]"
+        << std::setw( 14 ) << "CPU [ms]" << "\n";
+   writeTime( rOut, c_cppName, cpp );
+   writeTime( rOut, c_preparseName, preparse );
+   writeTime( rOut, c_cacheName, cache );
+   writeTime( rOut, c_collectName, collect );
+   writeTime( rOut, c_transitionsName, transitions );
+   writeTime( rOut, "clustering", m_clustering );
+   writeTime( rOut, "print", m_print );
+   writeTime( rOut, "run", m_run );
+   rOut << std::flush;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void Statistics::writeJsonString( std::ostream& rOut, const std::string& rStr )
+{
+   static const char c_hex[] = "0123456789abcdef";
+   rOut << '"';
+   for( const auto& c : rStr )
+   {
+      switch( c )
+      {
+         case '"':  rOut << "\\\""; break;
+         case '\\': rOut << "\\\\"; break;
+         case '\n': rOut << "\\n";  break;
+         case '\t': rOut << "\\t";  break;
+         default:
+         {
+            if( static_cast<unsigned char>( c ) < ' ' )
+            {
+               rOut << "\\u00" << c_hex[(c >> 4) & 0x0F] << c_hex[c & 0x0F];
+               break;
+            }
+            rOut << c;
+            break;
+         }
+      }
+   }
+   rOut << '"';
+}
+
+/*!----------------------------------------------------------------------------
+*/
+static void writeJsonTime( std::ostream& rOut, const char* pName,
+                           const StopWatch& rWatch, bool last = false )
+{
+   rOut << "\"" << pName << "\": { \"wall_ms\": " << rWatch.getWall() * 1000.0
+        << ", \"cpu_ms\": " << rWatch.getCpu() * 1000.0
+        << (last? " }" : " }, ");
+}
+
+/*!----------------------------------------------------------------------------
+*/
+static void writeJsonCounters( std::ostream& rOut,
+                               const Statistics::COUNTERS_T& rCounters )
+{
+   rOut << "\"words\": " << rCounters.m_words
+        << ", \"finds\": " << rCounters.m_finds
+        << ", \"states\": " << rCounters.m_states
+        << ", \"transitions\": " << rCounters.m_transitions
+        << ", \"attributes\": " << rCounters.m_attributes;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void Statistics::writeJson( std::ostream& rOut )
+{
+   StopWatch cpp, preparse, cache, collect, transitions;
+   COUNTERS_T counters;
+   std::size_t sourceBytes = 0;
+   std::size_t preprocessedBytes = 0;
+   std::size_t preparsedBytes = 0;
+
+   rOut << std::fixed << std::setprecision( 3 );
+   rOut << "{\n  \"version\": \"" DOCFSM_VERSION "\",\n  \"files\": [";
+   bool first = true;
+   for( const auto& rFile : m_vFiles )
+   {
+      rOut << (first? "\n    { \"name\": " : ",\n    { \"name\": ");
+      first = false;
+      writeJsonString( rOut, rFile.m_name );
+      rOut << ", \"cached\": " << (rFile.m_cached? "true" : "false")
+           << ", \"prefiltered\": " << (rFile.m_preprocess.m_prefiltered? "true" : "false")
+           << ", \"source_bytes\": " << rFile.m_sourceBytes
+           << ", \"preprocessed_bytes\": " << rFile.m_preprocess.m_preprocessedBytes
+           << ", \"preparsed_bytes\": " << rFile.m_preprocess.m_preparsedBytes
+           << ", ";
+      writeJsonCounters( rOut, rFile.m_counters );
+      rOut << ",\n      \"stages\": { ";
+      writeJsonTime( rOut, c_cppName, rFile.m_preprocess.m_cpp );
+      writeJsonTime( rOut, c_preparseName, rFile.m_preprocess.m_preparse );
+      writeJsonTime( rOut, c_cacheName, rFile.m_cache );
+      writeJsonTime( rOut, c_collectName, rFile.m_collect );
+      writeJsonTime( rOut, c_transitionsName, rFile.m_transitions, true );
+      rOut << " } }";
+
+      cpp.add( rFile.m_preprocess.m_cpp );
+      preparse.add( rFile.m_preprocess.m_preparse );
+      cache.add( rFile.m_cache );
+      collect.add( rFile.m_collect );
+      transitions.add( rFile.m_transitions );
+      counters.add( rFile.m_counters );
+      sourceBytes       += rFile.m_sourceBytes;
+      preprocessedBytes += rFile.m_preprocess.m_preprocessedBytes;
+      preparsedBytes    += rFile.m_preprocess.m_preparsedBytes;
+   }
+
+   rOut << "\n  ],\n  \"total\": { \"files\": " << m_vFiles.size()
+        << ", \"source_bytes\": " << sourceBytes
+        << ", \"preprocessed_bytes\": " << preprocessedBytes
+        << ", \"preparsed_bytes\": " << preparsedBytes << ", ";
+   writeJsonCounters( rOut, counters );
+   rOut << ",\n    \"stages\": { ";
+   writeJsonTime( rOut, c_cppName, cpp );
+   writeJsonTime( rOut, c_preparseName, preparse );
+   writeJsonTime( rOut, c_cacheName, cache );
+   writeJsonTime( rOut, c_collectName, collect );
+   writeJsonTime( rOut, c_transitionsName, transitions );
+   writeJsonTime( rOut, "clustering", m_clustering );
+   writeJsonTime( rOut, "print", m_print );
+   writeJsonTime( rOut, "run", m_run, true );
+   rOut << " } }\n}" << std::endl;
+}
+
+//================================== EOF ======================================
@@ -0,0 +1,174 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!   @brief Module records the times and counters of the processing stages  */
+/*!          of DocFsm for each source-file.                                 */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_statistics.hpp                                               */
+/*! @see     df_statistics.cpp                                               */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#ifndef _DF_STATISTICS_HPP
+#define _DF_STATISTICS_HPP
+
+#ifndef __DOCFSM__
+ #include <string>
+ #include <vector>
+ #include <ostream>
+ #include "df_commandline.hpp"
+ #include "df_stopwatch.hpp"
+#endif
+
+namespace DocFsm
+{
+
+class StateCollector;
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Collects the wall-clock and CPU times of the processing stages
+ *        and some counters for each source-file and prints them at the end
+ *        if the option "--stats" is given.
+ *
+ * The times of each file are taken by the CPU-clock of the thread which
+ * does the work plus the CPU time of the preprocessor child process,
+ * so they remain correct when the option "--jobs" is given.
+ */
+class Statistics
+{
+public:
+   enum FORMAT_T
+   {
+      NONE,
+      TEXT,
+      JSON
+   };
+
+   struct COUNTERS_T
+   {
+      std::size_t  m_words;
+      std::size_t  m_finds;
+      std::size_t  m_states;
+      std::size_t  m_transitions;
+      std::size_t  m_attributes;
+
+      COUNTERS_T( void )
+         :m_words( 0 )
+         ,m_finds( 0 )
+         ,m_states( 0 )
+         ,m_transitions( 0 )
+         ,m_attributes( 0 )
+      {}
+
+      void add( const COUNTERS_T& rCounters );
+   };
+
+   /*!
+    * @brief Result of the preprocessor and the preparser, becomes taken
+    *        in the thread which runs them.
+    */
+   struct PREPROCESS_T
+   {
+      StopWatch    m_cpp;
+      StopWatch    m_preparse;
+      std::size_t  m_preprocessedBytes;
+      std::size_t  m_preparsedBytes;
+      /*!
+       * @brief File without keywords, neither preprocessed nor preparsed.
+       */
+      bool         m_prefiltered;
+
+      PREPROCESS_T( void )
+         :m_cpp( StopWatch::THREAD )
+         ,m_preparse( StopWatch::THREAD )
+         ,m_preprocessedBytes( 0 )
+         ,m_preparsedBytes( 0 )
+         ,m_prefiltered( false )
+      {}
+   };
+
+   struct FILE_T
+   {
+      std::string   m_name;
+      bool          m_cached;
+      std::size_t   m_sourceBytes;
+      PREPROCESS_T  m_preprocess;
+      StopWatch     m_cache;
+      StopWatch     m_collect;
+      StopWatch     m_transitions;
+      COUNTERS_T    m_counters;
+      std::size_t   m_firstModule;
+
+      FILE_T( const std::string& rName );
+   };
+
+private:
+   class OptionStats: public CLOP::OPTION_V
+   {
+      Statistics*   m_pParent;
+   public:
+      OptionStats( Statistics* pParent );
+      int onGiven( CLOP::PARSER* poParser ) override;
+   };
+
+   class OptionStatsFile: public CLOP::OPTION_V
+   {
+      Statistics*   m_pParent;
+   public:
+      OptionStatsFile( Statistics* pParent );
+      int onGiven( CLOP::PARSER* poParser ) override;
+   };
+
+   OptionStats          m_oOptionStats;
+   OptionStatsFile      m_oOptionStatsFile;
+   FORMAT_T             m_format;
+   std::string          m_fileName;
+   std::vector<FILE_T>  m_vFiles;
+   StopWatch            m_clustering;
+   StopWatch            m_print;
+   StopWatch            m_run;
+
+public:
+   Statistics( CommandlineParser& rParser );
+
+   bool isActive( void ) const { return m_format != NONE; }
+
+   /*!
+    * @brief Starts the measuring of the whole run.
+    */
+   void start( void ) { m_run.start(); }
+
+   /*!
+    * @brief Appends a record for the given file and takes the state of
+    *        the collector before processing it.
+    */
+   FILE_T& beginFile( const std::string& rFileName,
+                      const StateCollector& rCollector );
+
+   /*!
+    * @brief Completes the record of the current file by the counters of
+    *        the collector.
+    */
+   void endFile( const StateCollector& rCollector );
+
+   StopWatch& getClustering( void ) { return m_clustering; }
+   StopWatch& getPrint( void ) { return m_print; }
+
+   /*!
+    * @brief Writes the statistics in the desired format to stderr or to
+    *        the file given by option, if the option "--stats" is given.
+    * @retval true Error
+    */
+   bool write( void );
+
+private:
+   void writeText( std::ostream& rOut );
+   void writeJson( std::ostream& rOut );
+   static void writeJsonString( std::ostream& rOut, const std::string& rStr );
+};
+
+} // End namespace DocFsm
+#endif // ifndef _DF_STATISTICS_HPP
+//================================== EOF ======================================
@@ -0,0 +1,141 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!    @brief Stopwatch for measuring the wall-clock and CPU time of the     */
+/*!           processing stages of DocFsm.                                   */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_stopwatch.hpp                                                */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#ifndef _DF_STOPWATCH_HPP
+#define _DF_STOPWATCH_HPP
+
+#ifndef __DOCFSM__
+ #include <time.h>
+ #include <sys/resource.h>
+ #include <chrono>
+#endif
+
+namespace DocFsm
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Accumulates the wall-clock time and the CPU time between start()
+ *        and stop().
+ *
+ * By default the CPU time is the one of the whole process including
+ * its terminated child processes, so the external preprocessor "cpp"
+ * becomes considered as well.\n
+ * In the mode THREAD only the CPU time of the calling thread counts,
+ * that's necessary when several threads are running concurrently.
+ * The CPU time of child processes can be added by addCpu() then.
+ */
+class StopWatch
+{
+   using CLOCK_T = std::chrono::steady_clock;
+
+public:
+   enum CPU_T
+   {
+      PROCESS,
+      THREAD
+   };
+
+private:
+   CLOCK_T::time_point  m_wallStart;
+   CPU_T                m_mode;
+   double               m_cpuStart;
+   double               m_wall;
+   double               m_cpu;
+   bool                 m_running;
+
+public:
+   StopWatch( CPU_T mode = PROCESS )
+      :m_mode( mode )
+      ,m_cpuStart( 0.0 )
+      ,m_wall( 0.0 )
+      ,m_cpu( 0.0 )
+      ,m_running( false )
+   {}
+
+   void start( void )
+   {
+      m_running   = true;
+      m_cpuStart  = getCpuTime();
+      m_wallStart = CLOCK_T::now();
+   }
+
+   void stop( void )
+   {
+      if( !m_running )
+         return;
+      m_wall += std::chrono::duration<double>( CLOCK_T::now() - m_wallStart ).count();
+      m_cpu  += getCpuTime() - m_cpuStart;
+      m_running = false;
+   }
+
+   /*!
+    * @brief Adds the given CPU time in seconds, e.g. the one of a
+    *        child process.
+    */
+   void addCpu( double cpu ) { m_cpu += cpu; }
+
+   /*!
+    * @brief Adds the accumulated times of the given stopwatch.
+    */
+   void add( const StopWatch& rWatch )
+   {
+      m_wall += rWatch.m_wall;
+      m_cpu  += rWatch.m_cpu;
+   }
+
+   /*!
+    * @brief Accumulated wall-clock time in seconds.
+    */
+   double getWall( void ) const { return m_wall; }
+
+   /*!
+    * @brief Accumulated CPU time in seconds.
+    */
+   double getCpu( void ) const { return m_cpu; }
+
+   /*!
+    * @brief CPU time of the process including its terminated children
+    *        in seconds.
+    */
+   static double cpuTime( void )
+   {
+      struct timespec ts;
+      ::clock_gettime( CLOCK_PROCESS_CPUTIME_ID, &ts );
+      double t = ts.tv_sec + ts.tv_nsec * 1.0e-9;
+
+      struct rusage usage;
+      ::getrusage( RUSAGE_CHILDREN, &usage );
+      t += usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1.0e-6;
+      t += usage.ru_stime.tv_sec + usage.ru_stime.tv_usec * 1.0e-6;
+      return t;
+   }
+
+   /*!
+    * @brief CPU time of the calling thread in seconds.
+    */
+   static double threadCpuTime( void )
+   {
+      struct timespec ts;
+      ::clock_gettime( CLOCK_THREAD_CPUTIME_ID, &ts );
+      return ts.tv_sec + ts.tv_nsec * 1.0e-9;
+   }
+
+private:
+   double getCpuTime( void ) const
+   {
+      return (m_mode == THREAD)? threadCpuTime() : cpuTime();
+   }
+};
+
+} // End namespace DocFsm
+#endif // ifndef _DF_STOPWATCH_HPP
+//================================== EOF ======================================
@@ -0,0 +1,254 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!  @brief Main-module of DOCFSM_STRESS, checks the concurrent use of the   */
+/*!         class Extractor by several threads.                              */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_stress.cpp                                                   */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#include <stdlib.h>
+#include <unistd.h>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <atomic>
+
+#include "df_commandline.hpp"
+#include "df_extractor.hpp"
+#include "df_fsm_generator.hpp"
+#include "df_docfsm.hpp"
+
+using namespace DocFsm;
+
+#define DEFAULT_THREADS 8
+#define DEFAULT_ROUNDS  10
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Option with a positive number as parameter.
+ */
+class OptionNumber: public CLOP::OPTION_V
+{
+   unsigned int&  m_rNumber;
+
+public:
+   OptionNumber( unsigned int& rNumber, const char* pLongOpt,
+                 const char* pHelpText )
+      :m_rNumber( rNumber )
+   {
+      m_hasArg   = REQUIRED_ARG;
+      m_shortOpt = '\0';
+      m_longOpt  = pLongOpt;
+      m_helpText = pHelpText;
+   }
+
+   int onGiven( CLOP::PARSER* poParser ) override
+   {
+      char* pEnd;
+      long number = ::strtol( poParser->getOptArg().c_str(), &pEnd, 10 );
+      if( poParser->getOptArg().empty() || (*pEnd != '\0') || (number <= 0) )
+      {
+         ERROR_MESSAGE( "Invalid number: \"" << poParser->getOptArg() << "\"" );
+         return -1;
+      }
+      m_rNumber = number;
+      return 0;
+   }
+};
+
+/*!----------------------------------------------------------------------------
+*/
+static void removeGenerated( const std::string& rDirectory,
+                             const FsmGenerator::FILE_NAME_LIST_T& rFiles )
+{
+   for( auto& fileName : rFiles )
+      ::unlink( fileName.c_str() );
+   ::rmdir( rDirectory.c_str() );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+static bool readFile( const std::string& rFileName, std::string& rContent )
+{
+   std::ifstream file( rFileName.c_str() );
+   if( !file )
+   {
+      ERROR_MESSAGE( "Unable to read file \"" << rFileName << "\"!" );
+      return true;
+   }
+   std::stringstream content;
+   content << file.rdbuf();
+   rContent = content.str();
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Extracts the DOT-code of a single source, given in memory or
+ *        as file.
+ * @retval true Error
+ */
+static bool extract( const ExtractorConfig& rConfig,
+                     const std::string& rFileName, const std::string& rSource,
+                     bool fromFile, std::string& rDot )
+{
+   Extractor extractor( rConfig );
+   if( fromFile? extractor.addFile( rFileName ) :
+                 extractor.addSource( rFileName, rSource ) )
+      return true;
+
+   Extractor::STATE_LIST_T states;
+   extractor.getStates( states );
+   return extractor.getDot( rDot );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Each thread processes all sources in its own order, alternately
+ *        in memory and as file, and compares the results with the
+ *        references of the single-threaded run.
+ */
+static void stress( const ExtractorConfig& rConfig,
+                    const FsmGenerator::FILE_NAME_LIST_T& rFiles,
+                    const std::vector<std::string>& rSources,
+                    const std::vector<std::string>& rReferences,
+                    const std::vector<std::string>& rFileReferences,
+                    unsigned int thread, unsigned int rounds,
+                    std::atomic<unsigned int>& rRuns,
+                    std::atomic<unsigned int>& rFailures )
+{
+   for( unsigned int round = 0; round < rounds; round++ )
+   {
+      for( std::size_t n = 0; n < rFiles.size(); n++ )
+      {
+         const std::size_t i = (n + thread) % rFiles.size();
+         const bool fromFile = ((round + thread) % 2) != 0;
+         std::string dot;
+         if( extract( rConfig, rFiles[i], rSources[i], fromFile, dot ) ||
+             (dot != (fromFile? rFileReferences[i] : rReferences[i])) )
+         {
+            ERROR_MESSAGE( "Thread " << thread << ": Result of \"" << rFiles[i]
+                           << "\" differs from the single-threaded run!" );
+            rFailures++;
+         }
+         rRuns++;
+      }
+   }
+}
+
+//=============================================================================
+
+int main( int argc, char** ppArgv )
+{
+   try
+   {
+      unsigned int threads = DEFAULT_THREADS;
+      unsigned int rounds  = DEFAULT_ROUNDS;
+      CommandlineParser  oCommandlineParser( argc, ppArgv );
+      FsmGenerator       generator( oCommandlineParser );
+      OptionNumber       optionThreads( threads, "threads",
+                                        "Number of concurrently running threads.\n"
+                                        "Default: " TO_STRING( DEFAULT_THREADS ) );
+      OptionNumber       optionRounds( rounds, "rounds",
+                                       "Number of passes of each thread over all sources.\n"
+                                       "Default: " TO_STRING( DEFAULT_ROUNDS ) );
+      oCommandlineParser( optionThreads );
+      oCommandlineParser( optionRounds );
+
+      oCommandlineParser.setUsage(
+         "DocFsm-Stress checks the concurrent use of the library class Extractor.\n\n"
+         "Usage: " + std::string( ppArgv[0] ) + " [options,...] [C/C++ sourcefile ...]\n\n"
+         "Without source-files a synthetic corpus of FSMs becomes generated,\n"
+         "its size and shape is given by the options \"--gen-...\".\n"
+         "The DOT-code of each file becomes extracted single-threaded first.\n"
+         "Then several threads extract all files concurrently, each one by its\n"
+         "own Extractor object sharing one ExtractorConfig, and compare their\n"
+         "results with the single-threaded ones.\n"
+         "The program is built with the ThreadSanitizer when the compiler\n"
+         "supports it, so data races become reported too.\n\n"
+         "Example:\n" +
+         std::string( ppArgv[0] ) + " --threads 16 --gen-files 20 --gen-states 30" );
+
+      if( oCommandlineParser() < 0 )
+         return oCommandlineParser.isFinished()? EXIT_SUCCESS : EXIT_FAILURE;
+
+      FsmGenerator::FILE_NAME_LIST_T files = oCommandlineParser.getFileNameList();
+      std::string tempDirectory;
+      if( files.empty() )
+      {
+         std::string directory = generator.getDirectory();
+         if( directory.empty() )
+         {
+            char name[] = "/tmp/docfsm_stress.XXXXXX";
+            if( ::mkdtemp( name ) == nullptr )
+            {
+               ERROR_MESSAGE( "Unable to create temporary directory!" );
+               return EXIT_FAILURE;
+            }
+            directory = tempDirectory = name;
+         }
+         if( generator.generate( directory, files ) )
+         {
+            if( !tempDirectory.empty() )
+               removeGenerated( tempDirectory, files );
+            return EXIT_FAILURE;
+         }
+      }
+
+      const ExtractorConfig config;
+      if( !config.isValid() )
+         return EXIT_FAILURE;
+
+      std::vector<std::string> sources( files.size() );
+      std::vector<std::string> references( files.size() );
+      std::vector<std::string> fileReferences( files.size() );
+      bool error = false;
+      for( std::size_t i = 0; (i < files.size()) && !error; i++ )
+      {
+         error = readFile( files[i], sources[i] ) ||
+                 extract( config, files[i], sources[i], false, references[i] ) ||
+                 extract( config, files[i], sources[i], true, fileReferences[i] );
+         if( error )
+            ERROR_MESSAGE( "No reference of \"" << files[i] << "\"!" );
+      }
+
+      std::atomic<unsigned int> runs( 0 );
+      std::atomic<unsigned int> failures( 0 );
+      if( !error )
+      {
+         std::vector<std::thread> vThreads;
+         for( unsigned int i = 0; i < threads; i++ )
+         {
+            vThreads.emplace_back( stress, std::cref( config ), std::cref( files ),
+                                   std::cref( sources ), std::cref( references ),
+                                   std::cref( fileReferences ), i, rounds,
+                                   std::ref( runs ), std::ref( failures ) );
+         }
+         for( auto& rThread : vThreads )
+            rThread.join();
+      }
+
+      if( !tempDirectory.empty() )
+         removeGenerated( tempDirectory, files );
+
+      if( error )
+         return EXIT_FAILURE;
+
+      std::cout << "threads:  " << threads << "\n"
+                   "files:    " << files.size() << "\n"
+                   "runs:     " << runs << "\n"
+                   "failures: " << failures << std::endl;
+
+      if( failures != 0 )
+         return EXIT_FAILURE;
+   }
+   catch( ... )
+   {
+      ERROR_MESSAGE( "Exception: perhaps not enough memory!" );
+      return EXIT_FAILURE;
+   }
+   return EXIT_SUCCESS;
+}
+
+//================================== EOF ======================================
@@ -76,8 +76,8 @@ using namespace DocFsm;
 ///////////////////////////////////////////////////////////////////////////////
 /*!----------------------------------------------------------------------------
 */
-TransitionFinder::OptionNoMerge::OptionNoMerge( void )
-   :m_do( false )
+TransitionFinder::OptionNoMerge::OptionNoMerge( bool noMerge )
+   :m_do( noMerge )
 {
    m_hasArg   = NO_ARG;
    m_shortOpt = 'n';
@@ -112,11 +112,61 @@ TransitionFinder::TransitionFinder( StateCollector& rStates,
    rCommandlineparser( m_oOptionNoMerge );
 }
 
+/*!----------------------------------------------------------------------------
+*/
+TransitionFinder::TransitionFinder( const TransitionFinder& rOrigin,
+                                    StateCollector& rStates )
+   :KeywordInterpreter( rStates.getSourceBrowser() )
+   ,m_rStates( rStates )
+   ,m_currentEffectivChar( '\0' )
+   ,m_lastEffectiveChar( '\0' )
+   ,m_braceCount( 0 )
+   ,m_exitCount( -1 )
+   ,FSM_INIT_FSM( OUTSIDE_STATE, color=blue, label='Start' )
+   ,m_pStateGraph( nullptr )
+   ,m_pCurrentTransition( nullptr )
+   ,m_oOptionNoMerge( rOrigin.noMerge() )
+{
+}
+
 /*!----------------------------------------------------------------------------
 */
 TransitionFinder::~TransitionFinder( void )
 {}
 
+/*!----------------------------------------------------------------------------
+*/
+bool TransitionFinder::getContext( CONTEXT_T& rContext ) const
+{
+   rContext.m_currentState        = m_currentState;
+   rContext.m_newState            = m_newState;
+   rContext.m_braceCount          = m_braceCount;
+   rContext.m_currentEffectivChar = m_currentEffectivChar;
+   rContext.m_lastEffectiveChar   = m_lastEffectiveChar;
+   return (m_pStateGraph != nullptr) || (m_pCurrentTransition != nullptr);
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void TransitionFinder::setContext( const CONTEXT_T& rContext )
+{
+   m_currentState        = static_cast<STATE_T>( rContext.m_currentState );
+   m_newState            = static_cast<STATE_T>( rContext.m_newState );
+   m_braceCount          = rContext.m_braceCount;
+   m_currentEffectivChar = rContext.m_currentEffectivChar;
+   m_lastEffectiveChar   = rContext.m_lastEffectiveChar;
+   m_pStateGraph         = nullptr;
+   m_pCurrentTransition  = nullptr;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+void TransitionFinder::resetContext( void )
+{
+   const CONTEXT_T context = { OUTSIDE_STATE, OUTSIDE_STATE, 0, '\0', '\0' };
+   setContext( context );
+}
+
 /*!----------------------------------------------------------------------------
 */
 #ifdef _DEBUG_TRANSITION_FINDER_FSM
@@ -155,10 +205,19 @@ void TransitionFinder::onChar( char c )
    m_lastEffectiveChar = c;
 }
 
+/*!----------------------------------------------------------------------------
+*/
+void TransitionFinder::onKeywordChars( const char* pBegin, std::size_t len )
+{
+   KeywordInterpreter::onKeywordChars( pBegin, len );
+   m_lastEffectiveChar = '\0';
+}
+
 /*!----------------------------------------------------------------------------
 */
 void TransitionFinder::onRecognized( std::string word )
 {
+   m_rStates.countWord();
    m_sLastWord = word;
    fsmStep( WORD );
 }
@@ -246,9 +305,29 @@ void TransitionFinder::mergeAttributes( TransitionGraph& rPresent )
    }
    else
    {
-      rPresent.getAttrList().push_back( new ATTR_T( pCurrentAttr->first,
-                                             new std::string( *pCurrentAttr->second ) ));
+      Arena& rArena = m_rStates.getArena();
+      rPresent.getAttrList().push_back( rArena.create<ATTR_T>( pCurrentAttr->first,
+                                 rArena.create<std::string>( *pCurrentAttr->second ) ));
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ * The index of a state becomes built by its first transition in the current
+ * file, so it contains also the transitions of previous files or of the
+ * model-cache. The state names are unique, therefore the comparison of the
+ * target pointers is the same as the comparison of the target names.
+ */
+TransitionFinder::TARGET_INDEX_T&
+TransitionFinder::getTargetIndex( StateGraph* pStateGraph )
+{
+   const auto result = m_mergeIndex.emplace( pStateGraph, TARGET_INDEX_T() );
+   TARGET_INDEX_T& rIndex = result.first->second;
+   if( result.second )
+   {
+      for( const auto& pTransition : pStateGraph->getTransitionList() )
+         rIndex.emplace( pTransition->getTargetState(), pTransition );
    }
+   return rIndex;
 }
 
 /*!----------------------------------------------------------------------------
@@ -263,16 +342,15 @@ bool TransitionFinder::addTransition( void )
 
    if( !m_oOptionNoMerge() )
    {
-      for( const auto& pTransition : m_pStateGraph->getTransitionList() )
+      TransitionGraph*& rpPresent =
+         getTargetIndex( m_pStateGraph )[m_pCurrentTransition->getTargetState()];
+      if( rpPresent != nullptr )
       {
-         if( pTransition->getTargetState()->getName() != 
-             m_pCurrentTransition->getTargetState()->getName() )
-            continue;
-         mergeAttributes( *pTransition );
-         delete m_pCurrentTransition;
+         mergeAttributes( *rpPresent );
          m_pCurrentTransition = nullptr;
          return false;
       }
+      rpPresent = m_pCurrentTransition;
    }
 
    m_pStateGraph->addTransition( m_pCurrentTransition );
@@ -298,7 +376,7 @@ bool TransitionFinder::generateExitState( void )
    pStateGraph->addAttribute( "color", "black" );
    pStateGraph->addAttribute( "label", "\"\"" );
 #endif
-   m_pCurrentTransition = new TransitionGraph( pStateGraph );
+   m_pCurrentTransition = m_rStates.getArena().create<TransitionGraph>( pStateGraph );
    return true;
 }
 
@@ -458,7 +536,8 @@ void TransitionFinder::fsmStep( const EVENT_T event )
                }
                case KeywordPool::TRANSITION_SELF:
                {
-                  m_pCurrentTransition = new TransitionGraph( m_pStateGraph );
+                  m_pCurrentTransition =
+                     m_rStates.getArena().create<TransitionGraph>( m_pStateGraph );
                   FSM_TRANSITION_NEXT( READ_ATTRIBUTES, color=cyan, label='Is transition-self keyword' );
                   break;
                }
@@ -502,7 +581,7 @@ void TransitionFinder::fsmStep( const EVENT_T event )
                FSM_TRANSITION_SELF(color=magenta);
                break;
             }
-            m_pCurrentTransition = new TransitionGraph( poState );
+            m_pCurrentTransition = m_rStates.getArena().create<TransitionGraph>( poState );
             FSM_TRANSITION( READ_ATTRIBUTES, color=cyan );
             break;
          } // End of case TRANSITION_ARGUNENTS
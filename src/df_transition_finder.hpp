@@ -14,6 +14,7 @@
 #define _DF_TRANSITION_FINDER_HPP
 
 #ifndef __DOCFSM__ // Accelerates DocFsm
+  #include <unordered_map>
   #include "df_dotgenerator.hpp"
   #include "df_state_collector.hpp"
   #include "df_attribute_reader.hpp"
@@ -49,11 +50,22 @@ class TransitionFinder: public KeywordInterpreter
       WORD
    };
 
+   /*!
+    * @brief Index of the transitions of a state by their target state.
+    */
+   using TARGET_INDEX_T = std::unordered_map<const StateGraph*, TransitionGraph*>;
+
+   /*!
+    * @brief Target indexes of the states which got a transition in the
+    *        current file, becomes cleared by each call of find().
+    */
+   using MERGE_INDEX_T = std::unordered_map<const StateGraph*, TARGET_INDEX_T>;
+
    class OptionNoMerge: public CLOP::OPTION_V
    {
       bool              m_do;
    public:
-      OptionNoMerge( void );
+      OptionNoMerge( bool noMerge = false );
       int onGiven( CLOP::PARSER* poParser ) override;
       bool operator()( void ) const { return m_do; }
    };
@@ -70,15 +82,37 @@ class TransitionFinder: public KeywordInterpreter
    StateGraph*         m_pStateGraph;
    TransitionGraph*    m_pCurrentTransition;
    OptionNoMerge       m_oOptionNoMerge;
+   MERGE_INDEX_T       m_mergeIndex;
 
 public:
+   /*!
+    * @brief State of the finder which is carried over from the end of a
+    *        file to the begin of the next file.
+    */
+   struct CONTEXT_T
+   {
+      int   m_currentState;
+      int   m_newState;
+      int   m_braceCount;
+      char  m_currentEffectivChar;
+      char  m_lastEffectiveChar;
+   };
+
    TransitionFinder( StateCollector& rStates, CommandlineParser& );
 
+   /*!
+    * @brief Further finder with the configuration given by the options
+    *        of rOrigin, working on the model of the given collector.
+    * @see StateCollector::StateCollector( const StateCollector&, SourceBrowser& )
+    */
+   TransitionFinder( const TransitionFinder& rOrigin, StateCollector& rStates );
+
    virtual ~TransitionFinder( void );
 
    bool find( void )
    {
       m_exitCount = -1;
+      m_mergeIndex.clear();
       return browse();
    }
 
@@ -87,9 +121,27 @@ public:
       return find();
    }
 
+   bool noMerge( void ) const { return m_oOptionNoMerge(); }
+
+   /*!
+    * @brief Copies the context which is carried over to the next file.
+    * @retval true The context refers to a state or a transition and
+    *              therefore it can't be carried over by a copy.
+    */
+   bool getContext( CONTEXT_T& rContext ) const;
+   void setContext( const CONTEXT_T& rContext );
+
+   /*!
+    * @brief Sets the context of the begin of a file, so the result of
+    *        a file doesn't depend on the files before, e.g. whether a
+    *        file without keywords has been skipped or not.
+    */
+   void resetContext( void );
+
 protected:
    bool isThisCharActual( const char );
    void onChar( char ) override;
+   void onKeywordChars( const char* pBegin, std::size_t len ) override;
    void onRecognized( std::string ) override;
 
 private:
@@ -97,6 +149,7 @@ private:
    bool handleBraceCount( void );
    static const ATTR_T* findAttribute(  TransitionGraph&, const DotKeywords::ID_T );
    void mergeAttributes( TransitionGraph& );
+   TARGET_INDEX_T& getTargetIndex( StateGraph* pStateGraph );
    bool addTransition( void );
    void startAttributeReaderTransition( ATTR_LIST_T& rAttrList );
    bool generateExitState( void );
@@ -0,0 +1,347 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!  @brief Module regenerates the DOT-files of changed source-files         */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_watcher.cpp                                                  */
+/*! @see     df_watcher.hpp                                                  */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <signal.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include "df_docfsm.hpp"
+#include "df_dot_writer.hpp"
+#include "df_watcher.hpp"
+
+using namespace DocFsm;
+
+/*!
+ * @brief Time in milliseconds without further changes before the
+ *        DOT-files become regenerated, editors use to write a file
+ *        in several steps.
+ */
+#define SETTLE_TIME 100
+
+static volatile sig_atomic_t g_stop = 0;
+
+/*!----------------------------------------------------------------------------
+*/
+static void onStopSignal( int )
+{
+   g_stop = 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+Watcher::OptionWatch::OptionWatch( Watcher* pParent )
+   :m_pParent( pParent )
+{
+   m_hasArg   = REQUIRED_ARG;
+   m_shortOpt = '\0';
+   m_longOpt  = "watch";
+   m_helpText = "Generates for each source-file the DOT-file\n"
+                "\"PARAM/<source-file without extension>.gv\" and keeps\n"
+                "running: When a source-file or a file included by it has\n"
+                "been changed, so its DOT-file becomes generated again.\n"
+                "The directory PARAM has to exist, the DOT-files have to be\n"
+                "distinct like by \"--outdir\".\n"
+                "Terminates by SIGTERM or SIGINT.\n"
+                "E.g.: --watch doc/fsm *.c";
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int Watcher::OptionWatch::onGiven( CLOP::PARSER* poParser )
+{
+   if( poParser->getOptArg().empty() )
+   {
+      ERROR_MESSAGE( "Missing directory name for watch mode!" );
+      return -1;
+   }
+   m_pParent->m_directory = poParser->getOptArg();
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+*/
+Watcher::Watcher( CommandlineParser& rParser )
+   :m_oOptionWatch( this )
+   ,m_rParser( rParser )
+   ,m_fd( -1 )
+   ,m_run( nullptr )
+{
+   rParser( m_oOptionWatch );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+Watcher::~Watcher( void )
+{
+   if( m_fd >= 0 )
+      ::close( m_fd );
+}
+
+/*!----------------------------------------------------------------------------
+*/
+int Watcher::operator()( int argc, char** ppArgv, const FILE_NAME_LIST_T& rFiles,
+                         CppExecution& rCpp, Server::RUN_FUNCTION_T run )
+{
+   struct stat status;
+   if( (::stat( m_directory.c_str(), &status ) != 0) || !S_ISDIR( status.st_mode ) )
+   {
+      ERROR_MESSAGE( "Directory \"" << m_directory << "\" not found!" );
+      return EXIT_FAILURE;
+   }
+
+   if( DotWriter::checkFileNames( m_directory, rFiles ) )
+      return EXIT_FAILURE;
+
+   m_fd = ::inotify_init1( IN_CLOEXEC );
+   if( m_fd < 0 )
+   {
+      ERROR_MESSAGE( "Unable to initialize inotify: " << ::strerror( errno ) );
+      return EXIT_FAILURE;
+   }
+
+   /*
+    * The command line of each source-file consists of all options of
+    * the watcher's command line except "--watch".
+    */
+   m_run = run;
+   m_vDefaults.push_back( ppArgv[0] );
+   for( int i = 1; i < argc; i++ )
+   {
+      if( ::strcmp( ppArgv[i], "--watch" ) == 0 )
+      {
+         i++;
+         continue;
+      }
+      if( ::strncmp( ppArgv[i], "--watch=", 8 ) == 0 )
+         continue;
+      bool isSource = false;
+      for( const auto& rFile : rFiles )
+      {
+         if( rFile == ppArgv[i] )
+         {
+            isSource = true;
+            break;
+         }
+      }
+      if( !isSource )
+         m_vDefaults.push_back( ppArgv[i] );
+   }
+
+   for( const auto& rFile : rFiles )
+   {
+      SOURCE_T source;
+      source.m_name    = rFile;
+      source.m_dotFile = DotWriter::makeFileName( m_directory, rFile );
+      m_vSources.push_back( source );
+   }
+
+   for( std::size_t i = 0; i < m_vSources.size(); i++ )
+   {
+      if( update( i, rCpp ) )
+         return EXIT_FAILURE;
+      generate( i );
+   }
+
+   /*
+    * Without SA_RESTART, so poll() returns by the signals.
+    */
+   struct sigaction action;
+   ::memset( &action, 0, sizeof( action ) );
+   action.sa_handler = onStopSignal;
+   ::sigaction( SIGTERM, &action, nullptr );
+   ::sigaction( SIGINT, &action, nullptr );
+
+   std::set<std::size_t> pending;
+   char buffer[4096] __attribute__(( aligned( __alignof__( struct inotify_event ) ) ));
+   while( g_stop == 0 )
+   {
+      struct pollfd pollFd;
+      pollFd.fd      = m_fd;
+      pollFd.events  = POLLIN;
+      pollFd.revents = 0;
+      int ret = ::poll( &pollFd, 1, pending.empty()? -1 : SETTLE_TIME );
+      if( ret < 0 )
+      {
+         if( errno == EINTR )
+            continue;
+         ERROR_MESSAGE( "Unable to poll inotify: " << ::strerror( errno ) );
+         return EXIT_FAILURE;
+      }
+
+      if( ret == 0 )
+      { /*
+         * No further changes within the settle time.
+         */
+         for( const auto& index : pending )
+         {
+            if( update( index, rCpp ) )
+               return EXIT_FAILURE;
+            generate( index );
+         }
+         pending.clear();
+         continue;
+      }
+
+      ssize_t len = ::read( m_fd, buffer, sizeof( buffer ) );
+      if( len < 0 )
+      {
+         if( errno == EINTR || errno == EAGAIN )
+            continue;
+         ERROR_MESSAGE( "Unable to read inotify: " << ::strerror( errno ) );
+         return EXIT_FAILURE;
+      }
+
+      const struct inotify_event* pEvent;
+      for( char* p = buffer; p < buffer + len;
+           p += sizeof( struct inotify_event ) + pEvent->len )
+      {
+         pEvent = reinterpret_cast<const struct inotify_event*>(p);
+         if( pEvent->len == 0 )
+            continue;
+         auto itDirectory = m_directories.find( pEvent->wd );
+         if( itDirectory == m_directories.end() )
+            continue;
+         auto it = m_dependents.find( itDirectory->second + '/' + pEvent->name );
+         if( it != m_dependents.end() )
+            pending.insert( it->second.begin(), it->second.end() );
+      }
+   }
+   return EXIT_SUCCESS;
+}
+
+/*!----------------------------------------------------------------------------
+ * Determines the files which the source-file depends on and watches their
+ * directories. The included files can change by a modification, therefore
+ * this becomes made after each change again.
+ */
+bool Watcher::update( std::size_t index, CppExecution& rCpp )
+{
+   for( auto& rDependent : m_dependents )
+      rDependent.second.erase( index );
+
+   FILE_NAME_LIST_T files;
+   if( rCpp.getDependencies( m_vSources[index].m_name, files ) )
+      files.clear();
+   files.push_back( m_vSources[index].m_name );
+
+   for( const auto& rFile : files )
+   {
+      std::string path;
+      if( realPath( rFile, path ) )
+         continue;
+      m_dependents[path].insert( index );
+      if( watchDirectory( path.substr( 0, path.rfind( '/' ) ) ) )
+         return true;
+   }
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool Watcher::watchDirectory( const std::string& rDirectory )
+{
+   if( m_watchedDirectories.count( rDirectory ) != 0 )
+      return false;
+
+   int wd = ::inotify_add_watch( m_fd, rDirectory.empty()? "/" : rDirectory.c_str(),
+                                 IN_CLOSE_WRITE | IN_MOVED_TO );
+   if( wd < 0 )
+   {
+      ERROR_MESSAGE( "Unable to watch directory \"" << rDirectory << "\": "
+                     << ::strerror( errno ) );
+      return true;
+   }
+   m_watchedDirectories.insert( rDirectory );
+   m_directories[wd] = rDirectory;
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool Watcher::generate( std::size_t index )
+{
+   const SOURCE_T& rSource = m_vSources[index];
+
+   std::cout.flush();
+   std::cerr.flush();
+
+   pid_t pid = ::fork();
+   if( pid == 0 )
+   {
+      ::signal( SIGTERM, SIG_DFL );
+      ::signal( SIGINT, SIG_DFL );
+      std::vector<char*> vpArgv;
+      for( const auto& rArg : m_vDefaults )
+         vpArgv.push_back( const_cast<char*>(rArg.c_str()) );
+      vpArgv.push_back( const_cast<char*>("-o") );
+      vpArgv.push_back( const_cast<char*>(rSource.m_dotFile.c_str()) );
+      vpArgv.push_back( const_cast<char*>(rSource.m_name.c_str()) );
+      vpArgv.push_back( nullptr );
+      ::exit( m_run( vpArgv.size() - 1, vpArgv.data() ) );
+   }
+   if( pid < 0 )
+   {
+      ERROR_MESSAGE( "Unable to fork: " << ::strerror( errno ) );
+      return true;
+   }
+
+   int status;
+   while( ::waitpid( pid, &status, 0 ) < 0 )
+   {
+      if( errno != EINTR )
+         return true;
+   }
+   if( !WIFEXITED( status ) || (WEXITSTATUS( status ) != EXIT_SUCCESS) )
+   {
+      WARNING_MESSAGE( "\"" << rSource.m_dotFile << "\" not generated!" );
+      return true;
+   }
+   if( m_rParser.isVerbose() )
+      std::cout << "Generated: \"" << rSource.m_dotFile << '"' << std::endl;
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+ * Files which doesn't exist yet, e.g. generated headers, get the real
+ * path of their directory.
+ */
+bool Watcher::realPath( const std::string& rName, std::string& rPath )
+{
+   char path[PATH_MAX];
+   if( ::realpath( rName.c_str(), path ) != nullptr )
+   {
+      rPath = path;
+      return false;
+   }
+
+   std::size_t i = rName.rfind( '/' );
+   std::string directory = (i == std::string::npos)? "." : rName.substr( 0, i );
+   if( directory.empty() )
+      directory = "/";
+   if( ::realpath( directory.c_str(), path ) == nullptr )
+      return true;
+   rPath = path;
+   if( rPath.back() != '/' )
+      rPath += '/';
+   rPath += (i == std::string::npos)? rName : rName.substr( i + 1 );
+   return false;
+}
+
+//================================== EOF ======================================
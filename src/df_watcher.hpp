@@ -0,0 +1,115 @@
+/*****************************************************************************/
+/*                                                                           */
+/*!  @brief Module regenerates the DOT-files of changed source-files         */
+/*                                                                           */
+/*---------------------------------------------------------------------------*/
+/*! @file    df_watcher.hpp                                                  */
+/*! @see     df_watcher.cpp                                                  */
+/*! @author  Ulrich Becker                                                   */
+/*! @date    17.10.2026                                                      */
+/*  Updates:                                                                 */
+/*****************************************************************************/
+#ifndef _DF_WATCHER_HPP
+#define _DF_WATCHER_HPP
+
+#ifndef __DOCFSM__
+ #include <string>
+ #include <vector>
+ #include <set>
+ #include <unordered_map>
+ #include "df_commandline.hpp"
+ #include "df_cpp_caller.hpp"
+ #include "df_server.hpp"
+#endif
+
+namespace DocFsm
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Watch mode given by the option "--watch DIR".
+ *
+ * For each source-file of the command line the DOT-file
+ * "DIR/<source-file without extension>.gv" becomes generated. After that
+ * the source-files and the files included by them, as reported by the
+ * preprocessor, become watched by inotify. When one of them has been
+ * changed, so only the DOT-files of the source-files which depend on it
+ * become generated again.
+ *
+ * Each source-file becomes processed as own module by a forked copy of the
+ * process, like a call "docfsm -o DIR/<name>.gv <source-file>" with the
+ * further options of the command line would do.
+ */
+class Watcher
+{
+public:
+   using FILE_NAME_LIST_T = std::vector<std::string>;
+
+private:
+   class OptionWatch: public CLOP::OPTION_V
+   {
+      Watcher*   m_pParent;
+   public:
+      OptionWatch( Watcher* pParent );
+      int onGiven( CLOP::PARSER* poParser ) override;
+   };
+
+   struct SOURCE_T
+   {
+      std::string  m_name;
+      std::string  m_dotFile;
+   };
+
+   /*!
+    * @brief Real path of a watched file to the indexes of the
+    *        source-files which depend on it.
+    */
+   using DEPENDENTS_T = std::unordered_map<std::string, std::set<std::size_t>>;
+
+   /*!
+    * @brief Watch descriptor to the real path of the watched directory.
+    */
+   using DIRECTORIES_T = std::unordered_map<int, std::string>;
+
+   OptionWatch              m_oOptionWatch;
+   CommandlineParser&       m_rParser;
+   std::string              m_directory;
+   int                      m_fd;
+   FILE_NAME_LIST_T         m_vDefaults;
+   std::vector<SOURCE_T>    m_vSources;
+   DEPENDENTS_T             m_dependents;
+   DIRECTORIES_T            m_directories;
+   std::set<std::string>    m_watchedDirectories;
+   Server::RUN_FUNCTION_T   m_run;
+
+public:
+   Watcher( CommandlineParser& rParser );
+   ~Watcher( void );
+
+   bool isActive( void ) const { return !m_directory.empty(); }
+
+   /*!
+    * @brief Generates the DOT-files of all given source-files and
+    *        regenerates them after changes until the signal SIGTERM or
+    *        SIGINT becomes received.
+    * @param argc    Number of arguments of the command line.
+    * @param ppArgv  Arguments of the command line.
+    * @param rFiles  Source-files of the command line.
+    * @param rCpp    Preprocessor which reports the included files.
+    * @param run     Function which processes the command line of a
+    *                single source-file.
+    * @return Exit status.
+    */
+   int operator()( int argc, char** ppArgv, const FILE_NAME_LIST_T& rFiles,
+                   CppExecution& rCpp, Server::RUN_FUNCTION_T run );
+
+private:
+   bool update( std::size_t index, CppExecution& rCpp );
+   bool generate( std::size_t index );
+   bool watchDirectory( const std::string& rDirectory );
+   static bool realPath( const std::string& rName, std::string& rPath );
+};
+
+} // End namespace DocFsm
+#endif // ifndef _DF_WATCHER_HPP
+//================================== EOF ======================================
@@ -18,6 +18,9 @@
 #include <errno.h>
 #include <sys/types.h>
 #include <sys/wait.h>
+#include <sys/resource.h>
+#include <poll.h>
+#include <algorithm>
 #include "messages.hpp"
 #include "os_execute_linux.hpp"
 
@@ -27,9 +30,22 @@ using namespace OS;
 /*!----------------------------------------------------------------------------
 */
 
-Execution::Execution( std::ostream& rStdOstream, std::ostream& rErrOstream  )
-   :m_rStdOstream( rStdOstream )
+Execution::Execution( std::string& rStdBuffer, std::ostream& rErrOstream  )
+   :m_rStdBuffer( rStdBuffer )
    ,m_rErrOstream( rErrOstream )
+   ,m_childCpuTime( 0.0 )
+{
+}
+
+/*!----------------------------------------------------------------------------
+*/
+Execution::Execution( const Execution& rOrigin,
+                      std::string& rStdBuffer, std::ostream& rErrOstream )
+   :m_rStdBuffer( rStdBuffer )
+   ,m_rErrOstream( rErrOstream )
+   ,m_childCpuTime( 0.0 )
+   ,m_exe( rOrigin.m_exe )
+   ,m_oOptionList( rOrigin.m_oOptionList )
 {
 }
 
@@ -43,6 +59,7 @@ Execution::~Execution( void )
 */
 bool Execution::run( const std::string& rFilename )
 {
+   m_childCpuTime = 0.0;
 #if 1
    std::string bin = m_exe.substr(0, m_exe.find( ' ' ));
    if( ::access( bin.c_str(), X_OK ) != 0 )
@@ -61,116 +78,200 @@ bool Execution::run( const std::string& rFilename )
    if( m_outPipe() )
    {
       ERROR_MESSAGE( "Couldn't create stdout-pipe! " << ::strerror( errno ) );
+      m_inPipe.close();
       return true;
    }
 
    if( m_errPipe() )
    {
       ERROR_MESSAGE( "Couldn't create stederr-pipe! " << ::strerror( errno ) );
+      m_inPipe.close();
+      m_outPipe.close();
       return true;
    }
 
+   /*
+    * The argument list becomes built before forking, so the child process
+    * doesn't need to allocate memory. That's important when the parent
+    * process runs several threads.
+    */
+   OPTION_LIST_T optionList( m_oOptionList );
+   optionList.insert( optionList.begin(), m_exe );
+   optionList.push_back( rFilename );
+
+   std::vector<CHAR_STRING_T> argList( optionList.begin(), optionList.end() );
+   std::vector<char*> argv( argList.begin(), argList.end() );
+   argv.push_back( nullptr );
+
    m_pid = ::fork();
    if( m_pid < 0 )
    {
       ERROR_MESSAGE( "Couldn't fork to process \"" << m_exe << "\" "
                     << ::strerror( errno ) );
+      m_inPipe.close();
+      m_outPipe.close();
+      m_errPipe.close();
       return true;
    }
 
-   bool ret = false;
    if( m_pid == 0 )
-      runChildProcess( rFilename );
-   else
-      ret = runParentProcess();
+   {
+      runChildProcess( &argv[0] );
+      ::_exit( EXIT_FAILURE );
+   }
 
-   ::close( m_inPipe.fd.read );
-   ::close( m_outPipe.fd.write );
-   ::close( m_errPipe.fd.write );
+   bool ret = runParentProcess();
+
+   m_inPipe.close();
+   m_outPipe.close();
+   m_errPipe.close();
 
    return ret;
 }
 
 /*!----------------------------------------------------------------------------
-*/
+ * Blocks in poll() until one of the pipes becomes readable or has been
+ * closed by the child, so the parent doesn't consume CPU-time while the
+ * child is running. The child becomes reaped when both pipes are at the
+ * end of file.
+ */
 bool Execution::runParentProcess( void )
 {
-   int fdMax = m_outPipe.fd.read;
-   if( fdMax < m_errPipe.fd.read )
-      fdMax = m_errPipe.fd.read;
-   fdMax++;
+   /*
+    * The write-ends of the pipes belongs to the child only, otherwise
+    * the parent would never recognize the end of file.
+    */
+   m_inPipe.closeRead();
+   m_outPipe.closeWrite();
+   m_errPipe.closeWrite();
 
-   fd_set rfds;
-   int selectStade;
+   int outFd = m_outPipe.fd.read;
+   int errFd = m_errPipe.fd.read;
+   std::size_t outSize = m_rStdBuffer.size();
+   std::size_t errSize = 0;
    bool ret = false;
-   do
+   while( (outFd >= 0) || (errFd >= 0) )
    {
-      ssize_t size;
-      char buffer[1024];
-
-      FD_ZERO( &rfds );
-      FD_SET( m_outPipe.fd.read, &rfds );
-      FD_SET( m_errPipe.fd.read, &rfds );
-      struct timeval testIntervall = {0, 10};
-      selectStade = ::select( fdMax, &rfds, nullptr, nullptr, &testIntervall );
-      if( selectStade == 0 )
+      struct pollfd fds[2];
+      fds[0].fd = outFd;
+      fds[0].events = POLLIN;
+      fds[0].revents = 0;
+      fds[1].fd = errFd;
+      fds[1].events = POLLIN;
+      fds[1].revents = 0;
+
+      if( ::poll( fds, 2, -1 ) < 0 )
+      {
+         if( errno == EINTR )
+            continue;
+         ERROR_MESSAGE( "Polling pipes: " << ::strerror( errno ) );
+         ret = true;
+         break;
+      }
+
+      if( (fds[0].revents != 0) &&
+          readPipe( outFd, m_rStdBuffer, outSize, "stdout" ) )
+      {
+         ret = true;
+         break;
+      }
+      if( (fds[1].revents != 0) &&
+          readPipe( errFd, m_errBuffer, errSize, "stderr" ) )
       {
-         int processState;
-         if( m_pid == ::waitpid( m_pid, &processState, WNOHANG ) )
-         {
-            int exitStatus = WEXITSTATUS( processState );
-            if( exitStatus != EXIT_SUCCESS )
-            {
-               ERROR_MESSAGE( m_exe << " returns by state: " << exitStatus );
-               ret = true;
-            }
-            break;
-         }
+         ret = true;
+         break;
       }
-      else if( selectStade > 0 )
+      if( errSize > 0 )
       {
-         if( FD_ISSET( m_outPipe.fd.read, &rfds ) )
-         {
-            size = ::read( m_outPipe.fd.read, buffer, sizeof(buffer)-1 );
-            if( size < 0 )
-            {
-               ERROR_MESSAGE( "Reading stdout-pipe: " << ::strerror( errno ) );
-               ret = true;
-               break;
-            }
-            else
-            {
-               assert( size < sizeof(buffer) );
-               buffer[size] = '\0';
-               m_rStdOstream << buffer;
-            }
-         }
-         if( FD_ISSET( m_errPipe.fd.read, &rfds ) )
-         {
-            size = ::read( m_errPipe.fd.read, buffer, sizeof(buffer)-1 );
-            if( size < 0 )
-            {
-               ERROR_MESSAGE( "Reading stderr-pipe: " << ::strerror( errno ) );
-               ret = true;
-               break;
-            }
-            else if( size > 0 )
-            {
-               assert( size < sizeof(buffer) );
-               buffer[size] = '\0';
-               m_rErrOstream << buffer;
-            }
-         }
+         m_rErrOstream.write( &m_errBuffer[0], errSize );
+         errSize = 0;
       }
    }
-   while( selectStade >= 0 );
+   m_rStdBuffer.resize( outSize );
+
+   /*
+    * In the case of an error the closing of the read-ends terminates a
+    * still writing child by SIGPIPE, so waiting for it can't block forever.
+    */
+   m_outPipe.closeRead();
+   m_errPipe.closeRead();
+
+   if( waitForChild() )
+      ret = true;
 
    return ret;
 }
 
 /*!----------------------------------------------------------------------------
+ * Reads directly behind the already used part rSize of rBuffer, which
+ * becomes enlarged geometrically if necessary. So the output of the child
+ * process becomes copied only once from the pipe into the buffer.
+ */
+bool Execution::readPipe( int& rFd, std::string& rBuffer, std::size_t& rSize,
+                          const char* pName )
+{
+   if( rBuffer.size() < rSize + READ_BUFFER_SIZE )
+      rBuffer.resize( std::max( 2 * rBuffer.size(), rSize + READ_BUFFER_SIZE ) );
+
+   ssize_t size;
+   do
+      size = ::read( rFd, &rBuffer[rSize], rBuffer.size() - rSize );
+   while( (size < 0) && (errno == EINTR) );
+
+   if( size < 0 )
+   {
+      ERROR_MESSAGE( "Reading " << pName << "-pipe: " << ::strerror( errno ) );
+      return true;
+   }
+
+   if( size == 0 )
+   { // End of file, poll() ignores negative file-descriptors.
+      rFd = -1;
+      return false;
+   }
+
+   rSize += size;
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+ * Unlike getrusage( RUSAGE_CHILDREN ) wait4() delivers the resource usage of
+ * this child only, which is also correct when several threads are
+ * running children concurrently.
 */
-bool Execution::runChildProcess( const std::string& rFilename )
+bool Execution::waitForChild( void )
+{
+   int processState;
+   struct rusage usage;
+   while( ::wait4( m_pid, &processState, 0, &usage ) < 0 )
+   {
+      if( errno == EINTR )
+         continue;
+      ERROR_MESSAGE( "Waiting for \"" << m_exe << "\": " << ::strerror( errno ) );
+      return true;
+   }
+
+   m_childCpuTime = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1.0e-6 +
+                    usage.ru_stime.tv_sec + usage.ru_stime.tv_usec * 1.0e-6;
+
+   if( WIFSIGNALED( processState ) )
+   {
+      ERROR_MESSAGE( m_exe << " terminated by signal: " << WTERMSIG( processState ) );
+      return true;
+   }
+
+   int exitStatus = WEXITSTATUS( processState );
+   if( exitStatus != EXIT_SUCCESS )
+   {
+      ERROR_MESSAGE( m_exe << " returns by state: " << exitStatus );
+      return true;
+   }
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+*/
+bool Execution::runChildProcess( char** ppArgv )
 {
    if( ::dup2( m_inPipe.fd.read, STDIN_FILENO ) < 0 )
    {
@@ -195,18 +296,11 @@ bool Execution::runChildProcess( const std::string& rFilename )
    ::close( m_errPipe.fd.read );
    ::close( m_errPipe.fd.write );
 
-   m_oOptionList.push_back( rFilename );
-   m_oOptionList.insert( m_oOptionList.begin(), m_exe );
-
-   std::vector<CHAR_STRING_T> argList( m_oOptionList.begin(), m_oOptionList.end() );
-   std::vector<char*> argv( argList.begin(), argList.end() );
-   argv.push_back( nullptr );
-
 #ifdef _DEBUG
-   for( int i = 0; argv[i] != nullptr; i++ )
-      std::cerr << argv[i] << std::endl;
+   for( int i = 0; ppArgv[i] != nullptr; i++ )
+      std::cerr << ppArgv[i] << std::endl;
 #endif
-   if( ::execvp( argv[0], &argv[0] ) < 0 )
+   if( ::execvp( ppArgv[0], ppArgv ) < 0 )
    {
       ERROR_MESSAGE( "Could not execute \"" << m_exe << "\" "
                      << ::strerror( errno ) );
@@ -17,12 +17,19 @@
 
 #include <assert.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <string>
 #include <vector>
 
 namespace OS
 {
 
+/*!
+ * @brief Minimum free space in the buffers for reading the pipes of the
+ *        child process.
+ */
+#define READ_BUFFER_SIZE  (64 * 1024)
+
 ///////////////////////////////////////////////////////////////////////////////
 class Execution
 {
@@ -64,11 +71,35 @@ class Execution
       {
          assert( &fd.read  == &i[0] );
          assert( &fd.write == &i[1] );
+         fd.read  = -1;
+         fd.write = -1;
       }
 
       bool operator()( void )
       {
-         return (::pipe( i ) < 0);
+         return (::pipe2( i, O_CLOEXEC ) < 0);
+      }
+
+      void closeRead( void )
+      {
+         if( fd.read < 0 )
+            return;
+         ::close( fd.read );
+         fd.read = -1;
+      }
+
+      void closeWrite( void )
+      {
+         if( fd.write < 0 )
+            return;
+         ::close( fd.write );
+         fd.write = -1;
+      }
+
+      void close( void )
+      {
+         closeRead();
+         closeWrite();
       }
    };
 
@@ -76,22 +107,56 @@ class Execution
    PIPE_T                    m_inPipe;
    PIPE_T                    m_outPipe;
    PIPE_T                    m_errPipe;
-   std::ostream&             m_rStdOstream;
+   std::string&              m_rStdBuffer;
    std::ostream&             m_rErrOstream;
+   std::string               m_errBuffer;
+   double                    m_childCpuTime;
 
 protected:
    std::string               m_exe;
    OPTION_LIST_T             m_oOptionList;
 
-   Execution( std::ostream& rStdOstream, std::ostream& rErrOstream  );
+   /*!
+    * @param rStdBuffer Buffer where the standard output of the executable
+    *                   becomes appended to.
+    * @param rErrOstream Stream for the error output of the executable.
+    */
+   Execution( std::string& rStdBuffer, std::ostream& rErrOstream  );
+
+   /*!
+    * @brief Creates a further execution object with the same executable and
+    *        the same options as rOrigin but with own output streams.
+    */
+   Execution( const Execution& rOrigin,
+              std::string& rStdBuffer, std::ostream& rErrOstream );
    ~Execution( void );
 
+   std::string& getStdBuffer( void ) { return m_rStdBuffer; }
+   std::ostream& getErrOstream( void ) { return m_rErrOstream; }
+
+   /*!
+    * @brief For results delivered without starting a child process.
+    */
+   void resetChildCpuTime( void ) { m_childCpuTime = 0.0; }
+
 public:
    bool run( const std::string& rFilename );
 
+   /*!
+    * @brief CPU time in seconds of the child process of the last call of
+    *        run(), respectively zero if none has been terminated.
+    */
+   double getChildCpuTime( void ) const
+   {
+      return m_childCpuTime;
+   }
+
 private:
    bool runParentProcess( void );
-   bool runChildProcess( const std::string& rFilename );
+   bool readPipe( int& rFd, std::string& rBuffer, std::size_t& rSize,
+                  const char* pName );
+   bool waitForChild( void );
+   bool runChildProcess( char** ppArgv );
 };
 
 } // namespace OS